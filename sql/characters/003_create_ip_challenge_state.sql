@@ -0,0 +1,7 @@
+CREATE TABLE IF NOT EXISTS `ip_challenge_state` (
+  `guid` INT UNSIGNED NOT NULL,
+  `tier` TINYINT UNSIGNED NOT NULL DEFAULT 0,
+  `flags` INT UNSIGNED NOT NULL DEFAULT 0,
+  `updated_at` INT UNSIGNED NOT NULL DEFAULT 0,
+  PRIMARY KEY (`guid`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4 COLLATE=utf8mb4_unicode_ci;
@@ -0,0 +1,17 @@
+-- One-shot conversion of the legacy character_settings tier/flags rows into ip_challenge_state.
+-- Only active tiers (1-3) are carried over; rows already present in ip_challenge_state are kept as-is.
+INSERT INTO `ip_challenge_state` (`guid`, `tier`, `flags`, `updated_at`)
+SELECT
+  `t`.`guid`,
+  CAST(`t`.`data` AS UNSIGNED),
+  COALESCE(CAST(`f`.`data` AS UNSIGNED), 0),
+  UNIX_TIMESTAMP()
+FROM `character_settings` `t`
+LEFT JOIN `character_settings` `f`
+  ON `f`.`guid` = `t`.`guid` AND `f`.`source` = 'mod-ip-challengesystem-flags'
+WHERE `t`.`source` = 'mod-ip-challengesystem-tier'
+  AND CAST(`t`.`data` AS UNSIGNED) BETWEEN 1 AND 3
+ON DUPLICATE KEY UPDATE `guid` = `ip_challenge_state`.`guid`;
+
+DELETE FROM `character_settings`
+WHERE `source` IN ('mod-ip-challengesystem-tier', 'mod-ip-challengesystem-flags');
@@ -0,0 +1,93 @@
+#include "ChallengeAccountIndex.h"
+#include "ChallengeDatabase.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <mutex>
+
+ChallengeAccountIndex& ChallengeAccountIndex::Instance()
+{
+    static ChallengeAccountIndex instance;
+    return instance;
+}
+
+void ChallengeAccountIndex::LoadFromDB()
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::unordered_map<uint32, Counts> accounts;
+    ChallengeDatabasePreparedStatement* stmt = ChallengeDatabase::Instance().GetPreparedStatement(CHALLENGE_SEL_ACCOUNT_HARDCORE_COUNTS);
+    if (PreparedQueryResult result = ChallengeDatabase::Instance().Query(stmt))
+    {
+        accounts.reserve(result->GetRowCount());
+        do
+        {
+            Field* fields = result->Fetch();
+            Counts& counts = accounts[fields[0].Get<uint32>()];
+            counts.characters = static_cast<uint32>(fields[1].Get<uint64>());
+            counts.hardcore = static_cast<uint32>(fields[2].Get<uint64>());
+        } while (result->NextRow());
+    }
+
+    {
+        std::unique_lock<std::shared_mutex> guard(_lock);
+        _accounts.swap(accounts);
+    }
+
+    LOG_INFO("server.loading", ">> Loaded character counts for {} accounts in {} ms", Size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+void ChallengeAccountIndex::AddCharacter(uint32 accountId)
+{
+    std::unique_lock<std::shared_mutex> guard(_lock);
+    ++_accounts[accountId].characters;
+}
+
+void ChallengeAccountIndex::RemoveCharacter(uint32 accountId, bool hardcore)
+{
+    std::unique_lock<std::shared_mutex> guard(_lock);
+    auto itr = _accounts.find(accountId);
+    if (itr == _accounts.end())
+        return;
+
+    Counts& counts = itr->second;
+    if (hardcore && counts.hardcore)
+        --counts.hardcore;
+
+    if (counts.characters > 1)
+        --counts.characters;
+    else
+        _accounts.erase(itr);
+}
+
+void ChallengeAccountIndex::UpdateHardcore(uint32 accountId, bool wasHardcore, bool hardcore)
+{
+    if (wasHardcore == hardcore)
+        return;
+
+    std::unique_lock<std::shared_mutex> guard(_lock);
+    auto itr = _accounts.find(accountId);
+    if (itr == _accounts.end())
+        return;
+
+    Counts& counts = itr->second;
+    if (hardcore)
+        counts.hardcore = std::min(counts.hardcore + 1, counts.characters);
+    else if (counts.hardcore)
+        --counts.hardcore;
+}
+
+bool ChallengeAccountIndex::IsHardcore(uint32 accountId) const
+{
+    std::shared_lock<std::shared_mutex> guard(_lock);
+    auto itr = _accounts.find(accountId);
+    return itr != _accounts.end() && itr->second.characters && itr->second.hardcore == itr->second.characters;
+}
+
+size_t ChallengeAccountIndex::Size() const
+{
+    std::shared_lock<std::shared_mutex> guard(_lock);
+    return _accounts.size();
+}
@@ -0,0 +1,44 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_ACCOUNT_INDEX_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_ACCOUNT_INDEX_H
+
+#include "Define.h"
+
+#include <shared_mutex>
+#include <unordered_map>
+
+/**
+ * ChallengeAccountIndex
+ *
+ * Per account: how many characters it has and how many of them are
+ * Hardcore. Loaded with one aggregated query at world startup, then kept
+ * in step by character creation/deletion and by every change published to
+ * ChallengeStateIndex, so "is every character on this account Hardcore"
+ * never queries the database.
+ */
+class ChallengeAccountIndex
+{
+public:
+    static ChallengeAccountIndex& Instance();
+
+    void LoadFromDB();
+    void AddCharacter(uint32 accountId);
+    void RemoveCharacter(uint32 accountId, bool hardcore);
+    void UpdateHardcore(uint32 accountId, bool wasHardcore, bool hardcore);
+    // True when the account has characters and all of them are Hardcore.
+    bool IsHardcore(uint32 accountId) const;
+    size_t Size() const;
+
+private:
+    ChallengeAccountIndex() = default;
+
+    struct Counts
+    {
+        uint32 characters = 0;
+        uint32 hardcore = 0;
+    };
+
+    mutable std::shared_mutex _lock;
+    std::unordered_map<uint32, Counts> _accounts;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_ACCOUNT_INDEX_H
@@ -0,0 +1,103 @@
+#include "ChallengeCommandMatcher.h"
+
+namespace
+{
+constexpr uint32 kNoNode = 0;
+
+bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+char Fold(char c)
+{
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+}
+
+std::string_view TrimLeft(std::string_view text)
+{
+    while (!text.empty() && IsSpace(text.front()))
+        text.remove_prefix(1);
+    return text;
+}
+}
+
+ChallengeCommandMatcher::ChallengeCommandMatcher()
+{
+    _nodes.emplace_back();
+}
+
+void ChallengeCommandMatcher::Add(std::string_view phrase, BotCommandKind kind)
+{
+    phrase = TrimLeft(phrase);
+    while (!phrase.empty() && IsSpace(phrase.back()))
+        phrase.remove_suffix(1);
+
+    if (phrase.empty() || kind == BotCommandKind::None)
+        return;
+
+    uint32 node = 0;
+    for (size_t i = 0; i < phrase.size(); ++i)
+    {
+        char c = Fold(phrase[i]);
+        if (IsSpace(c))
+        {
+            c = ' ';
+            while (i + 1 < phrase.size() && IsSpace(phrase[i + 1]))
+                ++i;
+        }
+
+        uint32 child = FindChild(node, c);
+        if (child == kNoNode)
+        {
+            child = static_cast<uint32>(_nodes.size());
+            _nodes[node].children.emplace_back(c, child);
+            _nodes.emplace_back();
+        }
+        node = child;
+    }
+
+    _nodes[node].kind = kind;
+    _kinds |= 1u << static_cast<uint8>(kind);
+}
+
+ChallengeCommandMatcher::Match ChallengeCommandMatcher::Classify(std::string_view text) const
+{
+    Match best;
+    text = TrimLeft(text);
+
+    uint32 node = 0;
+    size_t i = 0;
+    while (i < text.size())
+    {
+        char c = Fold(text[i]);
+        if (IsSpace(c))
+        {
+            c = ' ';
+            while (i + 1 < text.size() && IsSpace(text[i + 1]))
+                ++i;
+        }
+
+        node = FindChild(node, c);
+        if (node == kNoNode)
+            break;
+        ++i;
+
+        Node const& current = _nodes[node];
+        if (current.kind != BotCommandKind::None && c != ' ' && (i == text.size() || IsSpace(text[i])))
+        {
+            best.kind = current.kind;
+            best.args = TrimLeft(text.substr(i));
+        }
+    }
+
+    return best;
+}
+
+uint32 ChallengeCommandMatcher::FindChild(uint32 node, char c) const
+{
+    for (auto const& [edge, child] : _nodes[node].children)
+        if (edge == c)
+            return child;
+    return kNoNode;
+}
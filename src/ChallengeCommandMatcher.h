@@ -0,0 +1,60 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_COMMAND_MATCHER_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_COMMAND_MATCHER_H
+
+#include "Define.h"
+
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * What a chat line or command asks a playerbot to do.
+ */
+enum class BotCommandKind : uint8
+{
+    None = 0,
+    RandomBot,  // .playerbots rndbot ...
+    AddClass,   // .playerbots bot addclass ...
+    Add,        // .playerbots bot add|login <names>
+    AddAccount, // .playerbots bot addaccount <account>
+    Combat      // whispered/party bot control that grants combat advantage
+};
+
+/**
+ * ChallengeCommandMatcher
+ *
+ * Trie over command phrases, built once per config snapshot. Classify walks
+ * the leading bytes of a line a single time, case-insensitively and with
+ * whitespace runs folded to one space, and returns the longest phrase that
+ * ends on a word boundary. Lookups never allocate.
+ */
+class ChallengeCommandMatcher
+{
+public:
+    struct Match
+    {
+        BotCommandKind kind = BotCommandKind::None;
+        std::string_view args;
+    };
+
+    ChallengeCommandMatcher();
+
+    void Add(std::string_view phrase, BotCommandKind kind);
+    Match Classify(std::string_view text) const;
+
+    bool HasKind(BotCommandKind kind) const { return (_kinds & (1u << static_cast<uint8>(kind))) != 0; }
+
+private:
+    struct Node
+    {
+        std::vector<std::pair<char, uint32>> children;
+        BotCommandKind kind = BotCommandKind::None;
+    };
+
+    uint32 FindChild(uint32 node, char c) const;
+
+    std::vector<Node> _nodes;
+    uint32 _kinds = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_COMMAND_MATCHER_H
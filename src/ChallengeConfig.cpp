@@ -0,0 +1,175 @@
+#include "ChallengeConfig.h"
+#include "ChallengeSnapshot.h"
+#include "Config.h"
+#include "StringConvert.h"
+
+#include <memory>
+#include <sstream>
+
+namespace
+{
+struct MessageDescriptor
+{
+    ChallengeMessage id;
+    char const* key;
+    char const* fallback;
+};
+
+constexpr std::array<MessageDescriptor, static_cast<size_t>(ChallengeMessage::Count)> kMessageDescriptors =
+{{
+    { ChallengeMessage::GroupBlocked,            "ChallengeSystem.Message.GroupBlocked",            "Grouping is disabled by active Challenge restrictions." },
+    { ChallengeMessage::TradeBlocked,            "ChallengeSystem.Message.TradeBlocked",            "Trading is disabled by active Challenge restrictions." },
+    { ChallengeMessage::MailBlocked,             "ChallengeSystem.Message.MailBlocked",             "Mail is disabled by active Challenge restrictions." },
+    { ChallengeMessage::AuctionBlocked,          "ChallengeSystem.Message.AuctionBlocked",          "Auction House access is disabled by active Challenge restrictions." },
+    { ChallengeMessage::SummonBlocked,           "ChallengeSystem.Message.SummonBlocked",           "Summons are disabled by active Challenge restrictions." },
+    { ChallengeMessage::EquipBlocked,            "ChallengeSystem.Message.EquipBlocked",            "Equipping this item is disabled by active Challenge restrictions." },
+    { ChallengeMessage::GuildBankBlocked,        "ChallengeSystem.Message.GuildBankBlocked",        "Guild Bank access is disabled by active Challenge restrictions." },
+    { ChallengeMessage::ResurrectBlocked,        "ChallengeSystem.Message.ResurrectBlocked",        "Resurrection is disabled while permadeath is pending." },
+    { ChallengeMessage::PermadeathLockout,       "ChallengeSystem.Message.Permadeath.Lockout",      "This character is permanently dead. You may keep it as a memorial or delete it." },
+    { ChallengeMessage::HardcoreGuildJoined,     "ChallengeSystem.Message.HardcoreGuildJoined",     "You have been added to the Hardcore guild." },
+    { ChallengeMessage::HardcoreGuildMissing,    "ChallengeSystem.Message.HardcoreGuildMissing",    "Hardcore guild not found. Contact a GM." },
+    { ChallengeMessage::HardcoreGuildOtherGuild, "ChallengeSystem.Message.HardcoreGuildOtherGuild", "You are already in another guild. Leave it to join the Hardcore guild." },
+    { ChallengeMessage::HardcoreGuildJoinFailed, "ChallengeSystem.Message.HardcoreGuildJoinFailed", "Failed to join the Hardcore guild. Contact a GM." },
+    { ChallengeMessage::BotsBlocked,             "ChallengeSystem.Message.BotsBlocked",             "Player bots are disabled by active Challenge restrictions." },
+    { ChallengeMessage::RndBotsBlocked,          "ChallengeSystem.Message.RndBotsBlocked",          "Random bot summoning is disabled by active Challenge restrictions." },
+    { ChallengeMessage::BotsRequireHardcore,     "ChallengeSystem.Message.BotsRequireHardcore",     "Only Hardcore characters may be summoned as bots." },
+    { ChallengeMessage::BotCommandBlocked,       "ChallengeSystem.Message.BotCommandBlocked",       "Bot combat commands are disabled by active Challenge restrictions." },
+    { ChallengeMessage::MountBlocked,            "ChallengeSystem.Message.MountBlocked",            "Mounts are disabled by active Challenge restrictions." },
+}};
+
+constexpr bool MessageDescriptorsInOrder()
+{
+    for (size_t i = 0; i < kMessageDescriptors.size(); ++i)
+        if (static_cast<size_t>(kMessageDescriptors[i].id) != i)
+            return false;
+    return true;
+}
+
+static_assert(MessageDescriptorsInOrder(), "kMessageDescriptors must be indexed by ChallengeMessage");
+
+constexpr char const* kDefaultCombatCommands =
+    "attack,tank attack,max dps,cast,castnc,cheat,co,nc,pull,rti,focus heal targets";
+
+ChallengeCommandMatcher BuildBotCommandMatcher(std::string const& combatCommands)
+{
+    ChallengeCommandMatcher matcher;
+    matcher.Add("playerbots rndbot", BotCommandKind::RandomBot);
+    matcher.Add("playerbots bot addclass", BotCommandKind::AddClass);
+    matcher.Add("playerbots bot add", BotCommandKind::Add);
+    matcher.Add("playerbots bot login", BotCommandKind::Add);
+    matcher.Add("playerbots bot addaccount", BotCommandKind::AddAccount);
+
+    std::stringstream ss(combatCommands);
+    std::string token;
+    while (std::getline(ss, token, ','))
+        matcher.Add(token, BotCommandKind::Combat);
+
+    return matcher;
+}
+
+std::unique_ptr<ChallengeConfig> BuildDefaultConfig()
+{
+    auto config = std::make_unique<ChallengeConfig>();
+    config->botCommands = BuildBotCommandMatcher(kDefaultCombatCommands);
+    for (MessageDescriptor const& descriptor : kMessageDescriptors)
+        config->messages[static_cast<size_t>(descriptor.id)] = descriptor.fallback;
+    return config;
+}
+
+std::unordered_set<uint32> ParseSpellList(std::string const& value)
+{
+    std::unordered_set<uint32> spells;
+    std::stringstream ss(value);
+    std::string token;
+    while (std::getline(ss, token, ','))
+    {
+        if (auto parsed = Acore::StringTo<uint32>(token))
+            spells.insert(*parsed);
+    }
+    return spells;
+}
+
+ChallengeSnapshot<ChallengeConfig> sSnapshot;
+uint32 sGeneration = 0;
+}
+
+ChallengeConfig const& ChallengeConfig::Current()
+{
+    ChallengeConfig const* config = sSnapshot.Get();
+    if (config)
+        return *config;
+
+    // Hooks may run before the first OnAfterConfigLoad; serve built-in defaults.
+    static ChallengeConfig const defaults = *BuildDefaultConfig();
+    return defaults;
+}
+
+void ChallengeConfig::Reload()
+{
+    std::unique_ptr<ChallengeConfig> config = BuildDefaultConfig();
+
+    config->enabled = sConfigMgr->GetOption<bool>("ChallengeSystem.Enable", true);
+    config->groupGracePeriodSeconds = sConfigMgr->GetOption<uint32>("ChallengeSystem.GroupGracePeriod", 45);
+
+    config->hardcoreAutoReinviteGuild = sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.AutoReinviteGuild", true);
+    config->hardcoreGuildName = sConfigMgr->GetOption<std::string>("ChallengeSystem.Hardcore.GuildName", "");
+    config->hardcoreBlockPlayerBots = sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.BlockPlayerBots", true);
+    config->hardcoreAllowLfg = sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.AllowLfg", true);
+    config->soloOnlyAllowLfg = sConfigMgr->GetOption<bool>("ChallengeSystem.SoloOnly.AllowLfg", false);
+    config->botCommands = BuildBotCommandMatcher(
+        sConfigMgr->GetOption<std::string>("ChallengeSystem.Playerbots.CombatCommands", kDefaultCombatCommands));
+
+    config->permadeathEnabled = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.Enable", true);
+    config->permadeathKickDelaySeconds = sConfigMgr->GetOption<uint32>("ChallengeSystem.Permadeath.KickDelaySeconds", 30);
+    config->permadeathBroadcast = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.Broadcast", true);
+    config->permadeathBroadcastMessage = sConfigMgr->GetOption<std::string>("ChallengeSystem.Permadeath.BroadcastMessage",
+        config->permadeathBroadcastMessage);
+    config->permadeathCountPvPDeaths = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountPvPDeaths", false);
+    config->permadeathCountBattlegroundDeaths = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountBattlegroundDeaths", false);
+    config->permadeathCountArenaDeaths = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountArenaDeaths", false);
+    config->permadeathCountDuelDeaths = sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountDuelDeaths", false);
+    config->permadeathGhostMap = sConfigMgr->GetOption<uint32>("ChallengeSystem.Permadeath.GhostMap", 0);
+    config->permadeathGhostX = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostX", -11075.463f);
+    config->permadeathGhostY = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostY", -1795.9891f);
+    config->permadeathGhostZ = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostZ", 52.717907f);
+    config->permadeathGhostO = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostO", 0.043097086f);
+
+    config->lowQualityMaxQuality = static_cast<uint8>(sConfigMgr->GetOption<uint32>("ChallengeSystem.LowQualityOnly.MaxQuality", 1));
+    config->povertyGoldCap[1] = sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier1", 0);
+    config->povertyGoldCap[2] = sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier2", 0);
+    config->povertyGoldCap[3] = sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier3", 0);
+    config->halfXPMultiplier = sConfigMgr->GetOption<float>("ChallengeSystem.XP.HalfMultiplier", 0.5f);
+    config->quarterXPMultiplier = sConfigMgr->GetOption<float>("ChallengeSystem.XP.QuarterMultiplier", 0.25f);
+
+    config->noBuffsAllowPassive = sConfigMgr->GetOption<bool>("ChallengeSystem.NoBuffs.AllowPassive", true);
+    config->noBuffsAllowSpells = ParseSpellList(sConfigMgr->GetOption<std::string>("ChallengeSystem.NoBuffs.AllowSpells", ""));
+    config->noBuffsScanIntervalMs = sConfigMgr->GetOption<uint32>("ChallengeSystem.NoBuffs.ScanIntervalMs", 30000);
+
+    config->persistenceFlushIntervalMs = sConfigMgr->GetOption<uint32>("ChallengeSystem.Persistence.FlushIntervalMs", 1000);
+
+    config->traceEnabled = sConfigMgr->GetOption<bool>("ChallengeSystem.Trace.Enable", false);
+    config->traceDirectory = sConfigMgr->GetOption<std::string>("ChallengeSystem.Trace.Directory", "ip_challenge_traces");
+    config->traceFile = sConfigMgr->GetOption<std::string>("ChallengeSystem.Trace.File", "ip_challenge_trace.bin");
+
+    for (MessageDescriptor const& descriptor : kMessageDescriptors)
+    {
+        config->messages[static_cast<size_t>(descriptor.id)] =
+            sConfigMgr->GetOption<std::string>(descriptor.key, descriptor.fallback);
+    }
+
+    for (size_t i = 0; i < config->testAuras.size(); ++i)
+    {
+        RestrictionId restriction = static_cast<RestrictionId>(i);
+        config->testAuras[i] = sConfigMgr->GetOption<uint32>(ChallengeManager::GetTestAuraConfigKey(restriction), 0);
+        if (config->testAuras[i])
+            config->hasTestAuras = true;
+    }
+
+    config->generation = ++sGeneration;
+    sSnapshot.Publish(std::move(config));
+}
+
+void ChallengeConfig::ReclaimRetired()
+{
+    sSnapshot.Reclaim();
+}
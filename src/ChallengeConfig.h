@@ -0,0 +1,125 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_CONFIG_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_CONFIG_H
+
+#include "Define.h"
+#include "ChallengeCommandMatcher.h"
+#include "ChallengeManager.h"
+
+#include <array>
+#include <string>
+#include <unordered_set>
+
+/**
+ * Player-facing message ids.
+ *
+ * Order matches the message table in ChallengeConfig.cpp, which maps each id
+ * to its config key and built-in fallback text.
+ */
+enum class ChallengeMessage : uint8
+{
+    GroupBlocked = 0,
+    TradeBlocked,
+    MailBlocked,
+    AuctionBlocked,
+    SummonBlocked,
+    EquipBlocked,
+    GuildBankBlocked,
+    ResurrectBlocked,
+    PermadeathLockout,
+    HardcoreGuildJoined,
+    HardcoreGuildMissing,
+    HardcoreGuildOtherGuild,
+    HardcoreGuildJoinFailed,
+    BotsBlocked,
+    RndBotsBlocked,
+    BotsRequireHardcore,
+    BotCommandBlocked,
+    MountBlocked,
+    Count
+};
+
+/**
+ * ChallengeConfig
+ *
+ * Immutable, fully parsed snapshot of the module configuration.
+ *
+ * A new snapshot is built on every (re)load and published with a single
+ * atomic pointer store. Hooks read plain fields from Current() and never
+ * touch sConfigMgr. A superseded snapshot is freed a few world updates
+ * after the reload (ChallengeSnapshot), so references held by in-flight
+ * hooks stay valid; anything kept longer than one hook call compares
+ * generation instead of holding a pointer.
+ */
+struct ChallengeConfig
+{
+    static constexpr uint8 kTierMax = 3;
+
+    uint32 generation = 0; // bumped on every (re)load; 0 = built-in defaults
+    bool enabled = true;
+    uint32 groupGracePeriodSeconds = 45;
+
+    // Hardcore / Solo Only
+    bool hardcoreAutoReinviteGuild = true;
+    std::string hardcoreGuildName;
+    bool hardcoreBlockPlayerBots = true;
+    bool hardcoreAllowLfg = true;
+    bool soloOnlyAllowLfg = false;
+
+    // Playerbot recruitment commands plus ChallengeSystem.Playerbots.CombatCommands
+    ChallengeCommandMatcher botCommands;
+
+    // Permadeath
+    bool permadeathEnabled = true;
+    uint32 permadeathKickDelaySeconds = 30;
+    bool permadeathBroadcast = true;
+    std::string permadeathBroadcastMessage = "Hardcore runner {name} (Level {level}) has been slain. All hail the fallen!";
+    bool permadeathCountPvPDeaths = false;
+    bool permadeathCountBattlegroundDeaths = false;
+    bool permadeathCountArenaDeaths = false;
+    bool permadeathCountDuelDeaths = false;
+    uint32 permadeathGhostMap = 0;
+    float permadeathGhostX = -11075.463f;
+    float permadeathGhostY = -1795.9891f;
+    float permadeathGhostZ = 52.717907f;
+    float permadeathGhostO = 0.043097086f;
+
+    // Restriction tuning
+    uint8 lowQualityMaxQuality = 1;
+    std::array<uint32, kTierMax + 1> povertyGoldCap = {};
+    float halfXPMultiplier = 0.5f;
+    float quarterXPMultiplier = 0.25f;
+    bool noBuffsAllowPassive = true;
+    std::unordered_set<uint32> noBuffsAllowSpells;
+    uint32 noBuffsScanIntervalMs = 30000; // safety sweep; 0 = aura-apply hook only
+
+    // Persistence
+    uint32 persistenceFlushIntervalMs = 1000;
+
+    // Hook trace recording (ChallengeTraceRecorder)
+    bool traceEnabled = false;
+    std::string traceDirectory = "ip_challenge_traces";
+    std::string traceFile = "ip_challenge_trace.bin"; // inside traceDirectory
+
+    // Messages, indexed by ChallengeMessage
+    std::array<std::string, static_cast<size_t>(ChallengeMessage::Count)> messages;
+
+    // DEV test auras, indexed by RestrictionId (0 = disabled)
+    std::array<uint32, static_cast<size_t>(RestrictionId::Count)> testAuras = {};
+    bool hasTestAuras = false;
+
+    uint32 GetPovertyGoldCap(uint8 tier) const { return tier <= kTierMax ? povertyGoldCap[tier] : 0; }
+    bool HasPovertyCap() const { return povertyGoldCap[1] || povertyGoldCap[2] || povertyGoldCap[3]; }
+    uint32 GetTestAura(RestrictionId restriction) const { return testAuras[static_cast<size_t>(restriction)]; }
+    std::string const& GetMessage(ChallengeMessage message) const { return messages[static_cast<size_t>(message)]; }
+
+    // Currently published snapshot. Never null.
+    static ChallengeConfig const& Current();
+
+    // Build a new snapshot from sConfigMgr and publish it.
+    static void Reload();
+
+    // Free superseded snapshots no hook can still be reading. World update only.
+    static void ReclaimRetired();
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_CONFIG_H
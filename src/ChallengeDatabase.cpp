@@ -0,0 +1,314 @@
+#include "ChallengeDatabase.h"
+#include "Log.h"
+#include "MySQLConnection.h"
+#include "QueryResult.h"
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+
+namespace
+{
+struct StatementDescriptor
+{
+    ChallengeDatabaseStatements index;
+    char const* name;
+    char const* sql;
+    ChallengeDatabase::StatementKind kind;
+};
+
+constexpr StatementDescriptor kStatementDescriptors[] =
+{
+    { CHALLENGE_SEL_ALL_STATES, "CHALLENGE_SEL_ALL_STATES",
+        "SELECT guid, tier, flags FROM ip_challenge_state", ChallengeDatabase::StatementKind::Query },
+    { CHALLENGE_REP_STATE, "CHALLENGE_REP_STATE",
+        "REPLACE INTO ip_challenge_state (guid, tier, flags, updated_at) VALUES (?, ?, ?, ?)",
+        ChallengeDatabase::StatementKind::Execute },
+    { CHALLENGE_DEL_STATE, "CHALLENGE_DEL_STATE",
+        "DELETE FROM ip_challenge_state WHERE guid = ?", ChallengeDatabase::StatementKind::Execute },
+    { CHALLENGE_SEL_PERMADEAD_GUIDS, "CHALLENGE_SEL_PERMADEAD_GUIDS",
+        "SELECT guid FROM ip_permadeath WHERE is_dead <> 0 ORDER BY guid", ChallengeDatabase::StatementKind::Query },
+    { CHALLENGE_INS_PERMADEATH, "CHALLENGE_INS_PERMADEATH",
+        "INSERT INTO ip_permadeath (guid, is_dead, death_time, death_map, death_x, death_y, death_z, death_o, death_reason) "
+        "VALUES (?, 1, ?, ?, ?, ?, ?, ?, ?) "
+        "ON DUPLICATE KEY UPDATE is_dead = 1, death_time = VALUES(death_time), death_map = VALUES(death_map), "
+        "death_x = VALUES(death_x), death_y = VALUES(death_y), death_z = VALUES(death_z), death_o = VALUES(death_o), "
+        "death_reason = VALUES(death_reason)", ChallengeDatabase::StatementKind::Execute },
+    { CHALLENGE_INS_RUN_ACTIVE, "CHALLENGE_INS_RUN_ACTIVE",
+        "INSERT INTO ip_challenge_runs (guid, tier, state, picked_flags, failed_flags, successful_flags, started_at, ended_at) "
+        "VALUES (?, ?, ?, ?, 0, 0, ?, 0) "
+        "ON DUPLICATE KEY UPDATE state = VALUES(state), picked_flags = VALUES(picked_flags), failed_flags = 0, "
+        "successful_flags = 0, started_at = VALUES(started_at), ended_at = 0", ChallengeDatabase::StatementKind::Execute },
+    { CHALLENGE_INS_RUN_FAILED, "CHALLENGE_INS_RUN_FAILED",
+        "INSERT INTO ip_challenge_runs (guid, tier, state, picked_flags, failed_flags, ended_at) "
+        "VALUES (?, ?, ?, ?, ?, ?) "
+        "ON DUPLICATE KEY UPDATE state = VALUES(state), failed_flags = failed_flags | VALUES(failed_flags), "
+        "ended_at = VALUES(ended_at)", ChallengeDatabase::StatementKind::Execute },
+    // Hardcore as ChallengeManager::IsHardcoreGuid sees it: an active tier (1-3) with the Hardcore flag.
+    { CHALLENGE_SEL_ACCOUNT_HARDCORE_COUNTS, "CHALLENGE_SEL_ACCOUNT_HARDCORE_COUNTS",
+        "SELECT c.account, COUNT(*), COUNT(s.guid) FROM characters c "
+        "LEFT JOIN ip_challenge_state s ON s.guid = c.guid AND s.tier BETWEEN 1 AND 3 AND (s.flags & 1) <> 0 "
+        "WHERE c.account <> 0 GROUP BY c.account", ChallengeDatabase::StatementKind::Query },
+};
+
+static_assert(std::size(kStatementDescriptors) == MAX_CHALLENGE_DATABASE_STATEMENTS,
+    "kStatementDescriptors must cover ChallengeDatabaseStatements");
+
+constexpr bool StatementDescriptorsInOrder()
+{
+    for (size_t i = 0; i < std::size(kStatementDescriptors); ++i)
+        if (static_cast<size_t>(kStatementDescriptors[i].index) != i)
+            return false;
+    return true;
+}
+
+static_assert(StatementDescriptorsInOrder(), "kStatementDescriptors must be indexed by ChallengeDatabaseStatements");
+
+constexpr uint8 CountParameters(std::string_view sql)
+{
+    return static_cast<uint8>(std::count(sql.begin(), sql.end(), '?'));
+}
+}
+
+class ChallengeDatabaseConnection : public MySQLConnection
+{
+public:
+    explicit ChallengeDatabaseConnection(MySQLConnectionInfo& connectionInfo)
+        : MySQLConnection(connectionInfo, CONNECTION_SYNCH) {}
+
+protected:
+    void DoPrepareStatements() override
+    {
+        if (!m_reconnecting)
+            m_stmts.resize(MAX_CHALLENGE_DATABASE_STATEMENTS);
+
+        for (StatementDescriptor const& descriptor : kStatementDescriptors)
+            PrepareStatement(descriptor.index, descriptor.sql, CONNECTION_SYNCH);
+    }
+};
+
+ChallengeDatabase& ChallengeDatabase::Instance()
+{
+    static ChallengeDatabase instance;
+    return instance;
+}
+
+ChallengeDatabase::ChallengeDatabase() = default;
+
+ChallengeDatabase::~ChallengeDatabase()
+{
+    Close();
+}
+
+bool ChallengeDatabase::Open(std::string const& connectionInfo)
+{
+    if (IsOpen())
+        return true;
+
+    _connectionInfo = std::make_unique<MySQLConnectionInfo>(connectionInfo);
+    auto queryConnection = std::make_unique<ChallengeDatabaseConnection>(*_connectionInfo);
+    auto writeConnection = std::make_unique<ChallengeDatabaseConnection>(*_connectionInfo);
+
+    for (ChallengeDatabaseConnection* connection : { queryConnection.get(), writeConnection.get() })
+    {
+        if (connection->Open() != 0 || !connection->PrepareStatements())
+        {
+            LOG_ERROR("module", "ChallengeSystem: could not open the module's character database connections, "
+                "challenge state will not be loaded or saved");
+            return false;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_queryLock);
+        _queryConnection = std::move(queryConnection);
+    }
+
+    _writeConnection = std::move(writeConnection);
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _accepting = true;
+    }
+
+    _writer = std::thread(&ChallengeDatabase::WriterThread, this);
+    _open.store(true, std::memory_order_release);
+    return true;
+}
+
+void ChallengeDatabase::Close()
+{
+    if (!_open.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        _accepting = false;
+    }
+
+    _queueChanged.notify_all();
+    _writer.join();
+    _writeConnection.reset();
+
+    std::lock_guard<std::mutex> guard(_queryLock);
+    _queryConnection.reset();
+}
+
+ChallengeDatabasePreparedStatement* ChallengeDatabase::GetPreparedStatement(ChallengeDatabaseStatements index) const
+{
+    return new ChallengeDatabasePreparedStatement(index, CountParameters(kStatementDescriptors[index].sql));
+}
+
+PreparedQueryResult ChallengeDatabase::Query(ChallengeDatabasePreparedStatement* stmt)
+{
+    std::unique_ptr<ChallengeDatabasePreparedStatement> owned(stmt);
+
+    std::lock_guard<std::mutex> guard(_queryLock);
+    if (!_queryConnection)
+        return nullptr;
+
+    Clock::time_point start = Clock::now();
+    PreparedQueryResult result(_queryConnection->Query(stmt));
+    Record(stmt->GetIndex(), start);
+
+    if (!result || !result->GetRowCount())
+        return nullptr;
+
+    return result;
+}
+
+void ChallengeDatabase::CommitTransaction(ChallengeDatabaseTransaction trans)
+{
+    Enqueue(std::move(trans));
+}
+
+void ChallengeDatabase::DirectCommitTransaction(ChallengeDatabaseTransaction trans)
+{
+    uint64 ticket = Enqueue(std::move(trans));
+    if (!ticket)
+        return;
+
+    std::unique_lock<std::mutex> guard(_queueLock);
+    _queueChanged.wait(guard, [this, ticket] { return _committed >= ticket; });
+}
+
+uint64 ChallengeDatabase::Enqueue(ChallengeDatabaseTransaction trans)
+{
+    if (!trans || !trans->GetSize())
+        return 0;
+
+    uint64 ticket = 0;
+    {
+        std::lock_guard<std::mutex> guard(_queueLock);
+        if (_accepting)
+        {
+            _queue.push_back(trans);
+            ticket = ++_enqueued;
+        }
+    }
+
+    if (!ticket)
+    {
+        LOG_ERROR("module", "ChallengeSystem: database is not open, dropped a transaction of {} statements", trans->GetSize());
+        return 0;
+    }
+
+    _queueChanged.notify_all();
+    return ticket;
+}
+
+void ChallengeDatabase::WriterThread()
+{
+    std::unique_lock<std::mutex> guard(_queueLock);
+    while (true)
+    {
+        _queueChanged.wait(guard, [this] { return !_accepting || !_queue.empty(); });
+
+        // Close only stops the thread once everything queued is committed.
+        if (_queue.empty())
+            return;
+
+        ChallengeDatabaseTransaction trans = std::move(_queue.front());
+        _queue.pop_front();
+
+        guard.unlock();
+        ExecuteTransaction(*trans);
+        guard.lock();
+
+        ++_committed;
+        _queueChanged.notify_all();
+    }
+}
+
+void ChallengeDatabase::ExecuteTransaction(ChallengeTransaction& trans)
+{
+    _writeConnection->BeginTransaction();
+
+    for (std::unique_ptr<ChallengeDatabasePreparedStatement> const& stmt : trans._statements)
+    {
+        Clock::time_point start = Clock::now();
+        bool executed = _writeConnection->Execute(stmt.get());
+        Record(stmt->GetIndex(), start);
+
+        if (!executed)
+        {
+            LOG_ERROR("module", "ChallengeSystem: {} failed, rolled back a transaction of {} statements",
+                kStatementDescriptors[stmt->GetIndex()].name, trans.GetSize());
+            _writeConnection->RollbackTransaction();
+            return;
+        }
+    }
+
+    _writeConnection->CommitTransaction();
+}
+
+void ChallengeDatabase::Record(uint32 index, Clock::time_point start)
+{
+    uint64 micros = static_cast<uint64>(
+        std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+
+    Statement& statement = _statements[index];
+    statement.calls.fetch_add(1, std::memory_order_relaxed);
+    statement.totalMicros.fetch_add(micros, std::memory_order_relaxed);
+
+    uint64 previousMax = statement.maxMicros.load(std::memory_order_relaxed);
+    while (micros > previousMax &&
+           !statement.maxMicros.compare_exchange_weak(previousMax, micros, std::memory_order_relaxed))
+    {
+    }
+}
+
+std::vector<ChallengeDatabase::StatementStats> ChallengeDatabase::GetStats() const
+{
+    std::vector<StatementStats> stats;
+    stats.reserve(_statements.size());
+
+    for (size_t i = 0; i < _statements.size(); ++i)
+    {
+        Statement const& statement = _statements[i];
+
+        StatementStats entry;
+        entry.name = kStatementDescriptors[i].name;
+        entry.kind = kStatementDescriptors[i].kind;
+        entry.calls = statement.calls.load(std::memory_order_relaxed);
+        entry.totalMicros = statement.totalMicros.load(std::memory_order_relaxed);
+        entry.maxMicros = statement.maxMicros.load(std::memory_order_relaxed);
+        stats.push_back(entry);
+    }
+
+    std::sort(stats.begin(), stats.end(), [](StatementStats const& left, StatementStats const& right)
+    {
+        return left.totalMicros > right.totalMicros;
+    });
+
+    return stats;
+}
+
+void ChallengeDatabase::ResetStats()
+{
+    for (Statement& statement : _statements)
+    {
+        statement.calls.store(0, std::memory_order_relaxed);
+        statement.totalMicros.store(0, std::memory_order_relaxed);
+        statement.maxMicros.store(0, std::memory_order_relaxed);
+    }
+}
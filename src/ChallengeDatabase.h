@@ -0,0 +1,156 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_DATABASE_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_DATABASE_H
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "PreparedStatement.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Module-owned statement ids, mirroring the core's CharacterDatabaseStatements.
+ *
+ * Naming: CHALLENGE_{SEL|INS|REP|DEL|UPD}_<what>
+ *
+ * Write statements take one row each and are only issued by
+ * ChallengeWriteQueue.
+ */
+enum ChallengeDatabaseStatements : uint8
+{
+    CHALLENGE_SEL_ALL_STATES,
+    CHALLENGE_REP_STATE,
+    CHALLENGE_DEL_STATE,
+    CHALLENGE_SEL_PERMADEAD_GUIDS,
+    CHALLENGE_INS_PERMADEATH,
+    CHALLENGE_INS_RUN_ACTIVE,
+    CHALLENGE_INS_RUN_FAILED,
+    CHALLENGE_SEL_ACCOUNT_HARDCORE_COUNTS,
+
+    MAX_CHALLENGE_DATABASE_STATEMENTS
+};
+
+class ChallengeDatabaseConnection;
+struct MySQLConnectionInfo;
+
+using ChallengeDatabasePreparedStatement = PreparedStatement<ChallengeDatabaseConnection>;
+
+/**
+ * Statements committed together by the writer thread. Owns what is appended.
+ */
+class ChallengeTransaction
+{
+public:
+    void Append(ChallengeDatabasePreparedStatement* stmt) { _statements.emplace_back(stmt); }
+    size_t GetSize() const { return _statements.size(); }
+
+private:
+    friend class ChallengeDatabase;
+
+    std::vector<std::unique_ptr<ChallengeDatabasePreparedStatement>> _statements;
+};
+
+using ChallengeDatabaseTransaction = std::shared_ptr<ChallengeTransaction>;
+
+/**
+ * ChallengeDatabase
+ *
+ * The module's own connections to the character database, with every
+ * statement of ChallengeDatabaseStatements prepared on them once at Open.
+ * The core's CharacterDatabase pool only prepares its own enum, so the
+ * module cannot borrow it for prepared statements.
+ *
+ * Two connections: queries run synchronously on one (startup loads, on the
+ * calling thread), and committed transactions go to a writer thread that
+ * owns the other and runs each statement as a prepared execute inside one
+ * MySQL transaction.
+ *
+ * Every statement records call count and cumulative/max latency: the full
+ * round trip for queries, and execution on the writer thread for writes.
+ *
+ * Until Open succeeds, queries return no rows and commits are dropped.
+ */
+class ChallengeDatabase
+{
+public:
+    enum class StatementKind : uint8
+    {
+        Query,
+        Execute
+    };
+
+    struct StatementStats
+    {
+        char const* name = nullptr;
+        StatementKind kind = StatementKind::Execute;
+        uint64 calls = 0;
+        uint64 totalMicros = 0;
+        uint64 maxMicros = 0;
+    };
+
+    static ChallengeDatabase& Instance();
+
+    // connectionInfo is "host;port;user;password;database", as CharacterDatabaseInfo.
+    bool Open(std::string const& connectionInfo);
+    // Commits everything queued, then closes both connections.
+    void Close();
+    bool IsOpen() const { return _open.load(std::memory_order_acquire); }
+
+    ChallengeDatabasePreparedStatement* GetPreparedStatement(ChallengeDatabaseStatements index) const;
+
+    // Blocks until the rows arrive; takes ownership of stmt. Null when there are no rows.
+    PreparedQueryResult Query(ChallengeDatabasePreparedStatement* stmt);
+
+    ChallengeDatabaseTransaction BeginTransaction() const { return std::make_shared<ChallengeTransaction>(); }
+    void CommitTransaction(ChallengeDatabaseTransaction trans);
+    // As CommitTransaction, but returns only once the writer thread has committed it.
+    void DirectCommitTransaction(ChallengeDatabaseTransaction trans);
+
+    std::vector<StatementStats> GetStats() const;
+    void ResetStats();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Statement
+    {
+        std::atomic<uint64> calls{ 0 };
+        std::atomic<uint64> totalMicros{ 0 };
+        std::atomic<uint64> maxMicros{ 0 };
+    };
+
+    ChallengeDatabase();
+    ~ChallengeDatabase();
+
+    // Returns the transaction's ticket for DirectCommitTransaction, 0 when it was dropped.
+    uint64 Enqueue(ChallengeDatabaseTransaction trans);
+    void WriterThread();
+    void ExecuteTransaction(ChallengeTransaction& trans);
+    void Record(uint32 index, Clock::time_point start);
+
+    std::array<Statement, MAX_CHALLENGE_DATABASE_STATEMENTS> _statements;
+
+    std::atomic<bool> _open{ false };
+    std::unique_ptr<MySQLConnectionInfo> _connectionInfo; // the connections keep a reference
+    std::unique_ptr<ChallengeDatabaseConnection> _queryConnection;
+    std::unique_ptr<ChallengeDatabaseConnection> _writeConnection;
+    std::mutex _queryLock;
+
+    std::thread _writer;
+    std::mutex _queueLock;
+    std::condition_variable _queueChanged;
+    std::deque<ChallengeDatabaseTransaction> _queue;
+    uint64 _enqueued = 0;
+    uint64 _committed = 0; // transactions the writer has finished
+    bool _accepting = false; // a writer thread is running and takes new transactions
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_DATABASE_H
@@ -0,0 +1,138 @@
+#include "ChallengeGroupIndex.h"
+
+#include <mutex>
+
+bool IsGroupCompatible(ChallengeGroupMember const& joiner, ChallengeGroupSummary const& others)
+{
+    if (joiner.soloOnly)
+        return false;
+
+    if (others.members == 0)
+        return true;
+
+    if (others.soloOnly)
+        return false;
+
+    if (joiner.hardcore)
+        return others.hardcore[joiner.tier] == others.members;
+
+    return others.nonHardcore == others.members;
+}
+
+bool IsLfgCompatible(ChallengeGroupMember const& joiner, ChallengeGroupSummary const& others,
+    bool soloOnlyAllowed, bool hardcoreAllowed)
+{
+    if (!soloOnlyAllowed && (joiner.soloOnly || others.soloOnly))
+        return false;
+
+    if (!hardcoreAllowed && (joiner.hardcore || others.nonHardcore != others.members))
+        return false;
+
+    return true;
+}
+
+ChallengeGroupIndex& ChallengeGroupIndex::Instance()
+{
+    static ChallengeGroupIndex instance;
+    return instance;
+}
+
+void ChallengeGroupIndex::Seed(uint32 groupGuid, std::vector<std::pair<uint32, ChallengeGroupMember>> const& members)
+{
+    Shard& shard = GetShard(groupGuid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    Entry& entry = shard.groups[groupGuid];
+    entry.members.clear();
+    entry.summary = ChallengeGroupSummary();
+    for (auto const& [memberGuid, member] : members)
+    {
+        if (entry.members.emplace(memberGuid, member).second)
+            entry.summary.Add(member);
+    }
+
+    entry.seeded = true;
+    ++entry.version;
+}
+
+void ChallengeGroupIndex::SetMember(uint32 groupGuid, uint32 memberGuid, ChallengeGroupMember const& member)
+{
+    Shard& shard = GetShard(groupGuid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    Entry& entry = shard.groups[groupGuid];
+    if (!entry.seeded)
+    {
+        ++entry.version;
+        return;
+    }
+
+    auto [itr, inserted] = entry.members.try_emplace(memberGuid, member);
+    if (!inserted)
+    {
+        // Unchanged state leaves every member's cached validity intact.
+        if (itr->second == member)
+            return;
+
+        entry.summary.Remove(itr->second);
+        itr->second = member;
+    }
+
+    entry.summary.Add(member);
+    ++entry.version;
+}
+
+void ChallengeGroupIndex::RemoveMember(uint32 groupGuid, uint32 memberGuid)
+{
+    Shard& shard = GetShard(groupGuid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    Entry& entry = shard.groups[groupGuid];
+    ++entry.version;
+
+    auto itr = entry.members.find(memberGuid);
+    if (itr == entry.members.end())
+        return;
+
+    entry.summary.Remove(itr->second);
+    entry.members.erase(itr);
+}
+
+void ChallengeGroupIndex::Touch(uint32 groupGuid)
+{
+    Shard& shard = GetShard(groupGuid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    ++shard.groups[groupGuid].version;
+}
+
+void ChallengeGroupIndex::Erase(uint32 groupGuid)
+{
+    Shard& shard = GetShard(groupGuid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+    shard.groups.erase(groupGuid);
+}
+
+uint32 ChallengeGroupIndex::GetVersion(uint32 groupGuid) const
+{
+    Shard const& shard = GetShard(groupGuid);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    auto itr = shard.groups.find(groupGuid);
+    return itr != shard.groups.end() ? itr->second.version : 0;
+}
+
+bool ChallengeGroupIndex::GetSummary(uint32 groupGuid, uint32 excludeGuid, ChallengeGroupSummary& out) const
+{
+    Shard const& shard = GetShard(groupGuid);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    auto itr = shard.groups.find(groupGuid);
+    if (itr == shard.groups.end() || !itr->second.seeded)
+        return false;
+
+    Entry const& entry = itr->second;
+    out = entry.summary;
+    if (excludeGuid)
+    {
+        auto member = entry.members.find(excludeGuid);
+        if (member != entry.members.end())
+            out.Remove(member->second);
+    }
+
+    return true;
+}
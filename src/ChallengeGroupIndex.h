@@ -0,0 +1,134 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_GROUP_INDEX_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_GROUP_INDEX_H
+
+#include "Define.h"
+
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * How one member counts towards a group's compatibility summary.
+ */
+struct ChallengeGroupMember
+{
+    static constexpr uint8 kTierCount = 4;
+
+    bool soloOnly = false;
+    bool hardcore = false;
+    uint8 tier = 0; // active tier, below kTierCount
+
+    bool operator==(ChallengeGroupMember const& other) const
+    {
+        return soloOnly == other.soloOnly && hardcore == other.hardcore && tier == other.tier;
+    }
+};
+
+/**
+ * Member counts the group invite/accept rules are decided on.
+ */
+struct ChallengeGroupSummary
+{
+    uint32 members = 0;
+    uint32 soloOnly = 0;
+    uint32 nonHardcore = 0;
+    std::array<uint32, ChallengeGroupMember::kTierCount> hardcore = {}; // Hardcore members by tier
+
+    void Add(ChallengeGroupMember const& member) { Apply(member, 1); }
+    void Remove(ChallengeGroupMember const& member) { Apply(member, -1); }
+
+private:
+    void Apply(ChallengeGroupMember const& member, int32 delta)
+    {
+        members += delta;
+        if (member.soloOnly)
+            soloOnly += delta;
+        if (member.hardcore)
+            hardcore[member.tier] += delta;
+        else
+            nonHardcore += delta;
+    }
+};
+
+// Non-LFG rule: SOLO_ONLY never groups, Hardcore groups only with Hardcore of the same tier.
+bool IsGroupCompatible(ChallengeGroupMember const& joiner, ChallengeGroupSummary const& others);
+
+// LFG rule: SOLO_ONLY and Hardcore characters queue only where the config allows it.
+bool IsLfgCompatible(ChallengeGroupMember const& joiner, ChallengeGroupSummary const& others,
+    bool soloOnlyAllowed, bool hardcoreAllowed);
+
+/**
+ * ChallengeGroupIndex
+ *
+ * Per-group change counter and compatibility summary. GroupScript hooks
+ * and challenge-state changes of a member update the group's summary
+ * incrementally and bump its version; each member caches the version its
+ * group validity was last computed for, so the per-tick cost for a grouped
+ * player is one lookup and invite/accept checks never walk the member list.
+ *
+ * Groups loaded from the database at startup have no summary until they
+ * are first seeded with Seed(); until then GetSummary fails and membership
+ * events only bump the version. Such groups report version 0.
+ */
+class ChallengeGroupIndex
+{
+public:
+    static ChallengeGroupIndex& Instance();
+
+    void Seed(uint32 groupGuid, std::vector<std::pair<uint32, ChallengeGroupMember>> const& members);
+    void SetMember(uint32 groupGuid, uint32 memberGuid, ChallengeGroupMember const& member);
+    void RemoveMember(uint32 groupGuid, uint32 memberGuid);
+    void Touch(uint32 groupGuid);
+    void Erase(uint32 groupGuid);
+
+    uint32 GetVersion(uint32 groupGuid) const;
+
+    // Summary of every member except excludeGuid (0 = none). False if the group is not seeded.
+    bool GetSummary(uint32 groupGuid, uint32 excludeGuid, ChallengeGroupSummary& out) const;
+
+    // Calls fn(groupGuid, memberGuid, member) for every member of every seeded group.
+    template<typename Fn>
+    void ForEachMember(Fn&& fn) const
+    {
+        for (Shard const& shard : _shards)
+        {
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            for (auto const& [groupGuid, entry] : shard.groups)
+            {
+                if (!entry.seeded)
+                    continue;
+
+                for (auto const& [memberGuid, member] : entry.members)
+                    fn(groupGuid, memberGuid, member);
+            }
+        }
+    }
+
+private:
+    ChallengeGroupIndex() = default;
+
+    static constexpr size_t kShardCount = 16;
+
+    struct Entry
+    {
+        uint32 version = 0;
+        bool seeded = false;
+        std::unordered_map<uint32, ChallengeGroupMember> members;
+        ChallengeGroupSummary summary;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;
+        std::unordered_map<uint32, Entry> groups;
+    };
+
+    Shard& GetShard(uint32 groupGuid) { return _shards[groupGuid % kShardCount]; }
+    Shard const& GetShard(uint32 groupGuid) const { return _shards[groupGuid % kShardCount]; }
+
+    std::array<Shard, kShardCount> _shards;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_GROUP_INDEX_H
@@ -1,9 +1,19 @@
 #include "ChallengeManager.h"
+#include "ChallengeAccountIndex.h"
+#include "ChallengeConfig.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengePermadeathIndex.h"
+#include "ChallengePlayerState.h"
+#include "ChallengeSpellTable.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTimerWheel.h"
+#include "ChallengeTrace.h"
+#include "ChallengeWriteQueue.h"
 #include "ChallengeRestriction.h"
+#include "AccountMgr.h"
+#include "CharacterCache.h"
 #include "Chat.h"
-#include "Config.h"
 #include "DatabaseEnv.h"
-#include "Duration.h"
 #include "GameTime.h"
 #include "Group.h"
 #include "GuildMgr.h"
@@ -11,45 +21,69 @@
 #include "Mail.h"
 #include "ObjectAccessor.h"
 #include "Player.h"
+#include "SharedDefines.h"
+#include "SpellAuraDefines.h"
 #include "SpellAuras.h"
-#include "SpellInfo.h"
 #include "StringConvert.h"
 #include "StringFormat.h"
 #include "UpdateFields.h"
+#include "WorldSession.h"
 #include "WorldSessionMgr.h"
 
 #include <algorithm>
-#include <sstream>
+#include <array>
 
 namespace
 {
-constexpr char kSettingTierSource[] = "mod-ip-challengesystem-tier";
-constexpr char kSettingFlagsSource[] = "mod-ip-challengesystem-flags";
-
-constexpr char kRestrictionHardcoreManualGroup[] = "HC_MANUAL_GROUP_ONLY_WITH_HC_TIER";
-constexpr char kRestrictionSoloOnly[] = "SOLO_ONLY";
-constexpr char kRestrictionNoTrade[] = "NO_TRADE";
-constexpr char kRestrictionNoMail[] = "NO_MAIL";
-constexpr char kRestrictionNoAuction[] = "NO_AUCTION";
-constexpr char kRestrictionNoSummons[] = "NO_SUMMONS";
-constexpr char kRestrictionPermadeath[] = "PERMADEATH";
-constexpr char kRestrictionLowQualityOnly[] = "LOW_QUALITY_ONLY";
-constexpr char kRestrictionSelfCrafted[] = "SELF_CRAFTED";
-constexpr char kRestrictionPoverty[] = "POVERTY";
-constexpr char kRestrictionNoGuildBank[] = "NO_GUILD_BANK";
-constexpr char kRestrictionNoMounts[] = "NO_MOUNTS";
-constexpr char kRestrictionNoBuffs[] = "NO_BUFFS";
-constexpr char kRestrictionNoTalents[] = "NO_TALENTS";
-constexpr char kRestrictionNoQuestXP[] = "NO_QUEST_XP";
-constexpr char kRestrictionOnlyQuestXP[] = "ONLY_QUEST_XP";
-constexpr char kRestrictionHalfXP[] = "HALF_XP";
-constexpr char kRestrictionQuarterXP[] = "QUARTER_XP";
-constexpr char kRestrictionNoBots[] = "NO_BOTS";
+struct RestrictionDescriptor
+{
+    RestrictionId id;
+    char const* name;
+    uint32 flag;
+    char const* testAuraKey;
+};
+
+constexpr std::array<RestrictionDescriptor, static_cast<size_t>(RestrictionId::Count)> kRestrictionDescriptors =
+{{
+    { RestrictionId::HardcoreManualGroup, "HC_MANUAL_GROUP_ONLY_WITH_HC_TIER", ChallengeManager::FLAG_HARDCORE,         "ChallengeSystem.TestAura.Hardcore" },
+    { RestrictionId::SoloOnly,            "SOLO_ONLY",                         ChallengeManager::FLAG_SOLO_ONLY,        "ChallengeSystem.TestAura.SoloOnly" },
+    { RestrictionId::NoTrade,             "NO_TRADE",                          ChallengeManager::FLAG_NO_TRADE,         "ChallengeSystem.TestAura.NoTrade" },
+    { RestrictionId::NoMail,              "NO_MAIL",                           ChallengeManager::FLAG_NO_MAIL,          "ChallengeSystem.TestAura.NoMail" },
+    { RestrictionId::NoAuction,           "NO_AUCTION",                        ChallengeManager::FLAG_NO_AUCTION,       "ChallengeSystem.TestAura.NoAuction" },
+    { RestrictionId::NoSummons,           "NO_SUMMONS",                        ChallengeManager::FLAG_NO_SUMMONS,       "ChallengeSystem.TestAura.NoSummons" },
+    { RestrictionId::Permadeath,          "PERMADEATH",                        ChallengeManager::FLAG_PERMADEATH,       "ChallengeSystem.TestAura.Permadeath" },
+    { RestrictionId::LowQualityOnly,      "LOW_QUALITY_ONLY",                  ChallengeManager::FLAG_LOW_QUALITY_ONLY, "ChallengeSystem.TestAura.LowQualityOnly" },
+    { RestrictionId::SelfCrafted,         "SELF_CRAFTED",                      ChallengeManager::FLAG_SELF_CRAFTED,     "ChallengeSystem.TestAura.SelfCrafted" },
+    { RestrictionId::Poverty,             "POVERTY",                           ChallengeManager::FLAG_POVERTY,          "ChallengeSystem.TestAura.Poverty" },
+    { RestrictionId::NoGuildBank,         "NO_GUILD_BANK",                     ChallengeManager::FLAG_NO_GUILD_BANK,    "ChallengeSystem.TestAura.NoGuildBank" },
+    { RestrictionId::NoMounts,            "NO_MOUNTS",                         ChallengeManager::FLAG_NO_MOUNTS,        "ChallengeSystem.TestAura.NoMounts" },
+    { RestrictionId::NoBuffs,             "NO_BUFFS",                          ChallengeManager::FLAG_NO_BUFFS,         "ChallengeSystem.TestAura.NoBuffs" },
+    { RestrictionId::NoTalents,           "NO_TALENTS",                        ChallengeManager::FLAG_NO_TALENTS,       "ChallengeSystem.TestAura.NoTalents" },
+    { RestrictionId::NoQuestXP,           "NO_QUEST_XP",                       ChallengeManager::FLAG_NO_QUEST_XP,      "ChallengeSystem.TestAura.NoQuestXP" },
+    { RestrictionId::OnlyQuestXP,         "ONLY_QUEST_XP",                     ChallengeManager::FLAG_ONLY_QUEST_XP,    "ChallengeSystem.TestAura.OnlyQuestXP" },
+    { RestrictionId::HalfXP,              "HALF_XP",                           ChallengeManager::FLAG_HALF_XP,          "ChallengeSystem.TestAura.HalfXP" },
+    { RestrictionId::QuarterXP,           "QUARTER_XP",                        ChallengeManager::FLAG_QUARTER_XP,       "ChallengeSystem.TestAura.QuarterXP" },
+    { RestrictionId::NoBots,              "NO_BOTS",                           ChallengeManager::FLAG_NO_BOTS,          "ChallengeSystem.TestAura.NoBots" },
+}};
+
+constexpr bool RestrictionDescriptorsInOrder()
+{
+    for (size_t i = 0; i < kRestrictionDescriptors.size(); ++i)
+        if (static_cast<size_t>(kRestrictionDescriptors[i].id) != i)
+            return false;
+    return true;
+}
+
+static_assert(RestrictionDescriptorsInOrder(), "kRestrictionDescriptors must be indexed by RestrictionId");
+
+constexpr RestrictionDescriptor const& GetRestrictionDescriptor(RestrictionId restriction)
+{
+    return kRestrictionDescriptors[static_cast<size_t>(restriction)];
+}
 
 constexpr uint8 kTierMax = 3;
+constexpr uint32 kGroupWarningIntervalSeconds = 10;
 
-constexpr uint8 kRunStateActive = 2;
-constexpr uint8 kRunStateFailed = 3;
 
 enum class PermadeathReason : uint8
 {
@@ -62,69 +96,23 @@ enum class PermadeathReason : uint8
     Environment = 6
 };
 
-uint32 GetSettingUInt(uint32 guid, char const* source)
-{
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT data FROM character_settings WHERE guid = {} AND source = '{}' LIMIT 1", guid, source);
-    if (!result)
-        return 0;
-
-    Field* fields = result->Fetch();
-    std::string data = fields[0].Get<std::string>();
-    if (auto parsed = Acore::StringTo<uint32>(data))
-        return *parsed;
-
-    return 0;
-}
-
-void SetSettingUInt(uint32 guid, char const* source, uint32 value)
+bool HasTestAura(Player* player, ChallengeConfig const& config, RestrictionId restriction)
 {
-    std::string sourceStr(source);
-    CharacterDatabase.EscapeString(sourceStr);
-    CharacterDatabase.Execute(
-        "REPLACE INTO character_settings (guid, source, data) VALUES ({}, '{}', '{}')",
-        guid, sourceStr, value);
-}
-
-bool HasTestAura(Player* player, char const* configKey)
-{
-    if (!player)
-        return false;
-
-    uint32 auraId = sConfigMgr->GetOption<uint32>(configKey, 0);
+    uint32 auraId = config.GetTestAura(restriction);
     return auraId && player->HasAura(auraId);
 }
 
-bool IsPermadeathEnabled()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.Enable", true);
-}
-
-bool IsChallengeSystemEnabled()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Enable", true);
-}
-
-uint32 GetGroupGracePeriodSeconds()
+bool IsTestAura(ChallengeConfig const& config, uint32 spellId)
 {
-    return sConfigMgr->GetOption<uint32>("ChallengeSystem.GroupGracePeriod", 45);
-}
-
-uint32 GetPermadeathKickDelaySeconds()
-{
-    return sConfigMgr->GetOption<uint32>("ChallengeSystem.Permadeath.KickDelaySeconds", 30);
-}
+    if (!config.hasTestAuras)
+        return false;
 
-bool ShouldBroadcastPermadeath()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.Broadcast", true);
+    return std::find(config.testAuras.begin(), config.testAuras.end(), spellId) != config.testAuras.end();
 }
 
 std::string GetPermadeathBroadcastMessage(Player* player)
 {
-    std::string message = sConfigMgr->GetOption<std::string>(
-        "ChallengeSystem.Permadeath.BroadcastMessage",
-        "Hardcore runner {name} (Level {level}) has been slain. All hail the fallen!");
+    std::string message = ChallengeConfig::Current().permadeathBroadcastMessage;
 
     if (!player)
         return message;
@@ -148,26 +136,6 @@ std::string GetPermadeathBroadcastMessage(Player* player)
     return message;
 }
 
-bool ShouldCountPvPDeath()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountPvPDeaths", false);
-}
-
-bool ShouldCountBattlegroundDeath()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountBattlegroundDeaths", false);
-}
-
-bool ShouldCountArenaDeath()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountArenaDeaths", false);
-}
-
-bool ShouldCountDuelDeath()
-{
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Permadeath.CountDuelDeaths", false);
-}
-
 bool IsDuelDeath(Player* player)
 {
     if (!player || !player->duel)
@@ -176,31 +144,41 @@ bool IsDuelDeath(Player* player)
     return player->duel->State == DUEL_STATE_IN_PROGRESS;
 }
 
-bool ShouldAllowHardcoreLfg()
+void SendMessage(Player* player, ChallengeMessage messageId)
 {
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.AllowLfg", true);
+    if (!player || !player->GetSession())
+        return;
+
+    std::string const& message = ChallengeConfig::Current().GetMessage(messageId);
+    if (message.empty())
+        return;
+
+    ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
 }
 
-bool ShouldAllowSoloLfg()
+ChallengeGroupMember MakeGroupMember(uint8 tier, uint32 flags)
 {
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.SoloOnly.AllowLfg", false);
+    ChallengeGroupMember member;
+    member.soloOnly = (flags & ChallengeManager::FLAG_SOLO_ONLY) != 0;
+    member.hardcore = (flags & ChallengeManager::FLAG_HARDCORE) != 0;
+    member.tier = tier < ChallengeGroupMember::kTierCount ? tier : 0;
+    return member;
 }
 
-std::string GetMessage(Player* player, char const* key, char const* fallback)
+void Dismount(Player* player)
 {
-    if (!player || !player->GetSession())
-        return {};
-
-    return sConfigMgr->GetOption<std::string>(key, fallback);
+    player->Dismount();
+    player->RemoveAurasByType(SPELL_AURA_MOUNTED);
 }
 
-void SendMessage(Player* player, char const* key, char const* fallback)
+void SendGroupWarning(Player* player, uint32 secondsLeft)
 {
-    std::string message = GetMessage(player, key, fallback);
-    if (message.empty() || !player || !player->GetSession())
+    if (!player->GetSession())
         return;
 
-    ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
+    ChatHandler(player->GetSession()).SendSysMessage(
+        Acore::StringFormat("Challenge restriction: leave your group within {} seconds or you will be removed.",
+            secondsLeft).c_str());
 }
 
 void TryAutoJoinHardcoreGuild(Player* player)
@@ -208,18 +186,17 @@ void TryAutoJoinHardcoreGuild(Player* player)
     if (!player)
         return;
 
-    if (!sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.AutoReinviteGuild", true))
+    ChallengeConfig const& config = ChallengeConfig::Current();
+    if (!config.hardcoreAutoReinviteGuild)
         return;
 
-    std::string guildName = sConfigMgr->GetOption<std::string>("ChallengeSystem.Hardcore.GuildName", "");
-    if (guildName.empty())
+    if (config.hardcoreGuildName.empty())
         return;
 
-    Guild* guild = sGuildMgr->GetGuildByName(guildName);
+    Guild* guild = sGuildMgr->GetGuildByName(config.hardcoreGuildName);
     if (!guild)
     {
-        SendMessage(player, "ChallengeSystem.Message.HardcoreGuildMissing",
-            "Hardcore guild not found. Contact a GM.");
+        SendMessage(player, ChallengeMessage::HardcoreGuildMissing);
         return;
     }
 
@@ -228,86 +205,152 @@ void TryAutoJoinHardcoreGuild(Player* player)
 
     if (player->GetGuildId() != 0)
     {
-        SendMessage(player, "ChallengeSystem.Message.HardcoreGuildOtherGuild",
-            "You are already in another guild. Leave it to join the Hardcore guild.");
+        SendMessage(player, ChallengeMessage::HardcoreGuildOtherGuild);
         return;
     }
 
     if (guild->AddMember(player->GetGUID()))
-    {
-        SendMessage(player, "ChallengeSystem.Message.HardcoreGuildJoined",
-            "You have been added to the Hardcore guild.");
-    }
+        SendMessage(player, ChallengeMessage::HardcoreGuildJoined);
     else
+        SendMessage(player, ChallengeMessage::HardcoreGuildJoinFailed);
+}
+
+bool IsQuestXPSource(uint8 xpSource)
+{
+    return xpSource == XPSOURCE_QUEST || xpSource == XPSOURCE_QUEST_DF;
+}
+
+bool IsHardcoreState(uint8 tier, uint32 flags)
+{
+    return tier != 0 && (flags & ChallengeManager::FLAG_HARDCORE) != 0;
+}
+
+// First whitespace-delimited word of a command's arguments.
+std::string_view FirstArgument(std::string_view args)
+{
+    return args.substr(0, args.find_first_of(" \t"));
+}
+
+// Invokes fn for each non-empty comma-separated entry; stops early when fn returns false.
+template<typename Fn>
+bool ForEachCommaToken(std::string_view input, Fn&& fn)
+{
+    while (!input.empty())
     {
-        SendMessage(player, "ChallengeSystem.Message.HardcoreGuildJoinFailed",
-            "Failed to join the Hardcore guild. Contact a GM.");
+        size_t comma = input.find(',');
+        std::string_view token = input.substr(0, comma);
+        if (!token.empty() && !fn(token))
+            return false;
+
+        if (comma == std::string_view::npos)
+            break;
+        input.remove_prefix(comma + 1);
     }
+    return true;
 }
 
-uint32 GetPovertyGoldCap(uint8 tier)
+bool IsHardcoreBotAllowed(Player* master, std::string_view name)
 {
-    if (tier == 1)
-        return sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier1", 0);
-    if (tier == 2)
-        return sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier2", 0);
-    if (tier == 3)
-        return sConfigMgr->GetOption<uint32>("ChallengeSystem.Poverty.GoldCap.Tier3", 0);
-    return 0;
+    if (!master)
+        return false;
+
+    ObjectGuid guid = sCharacterCache->GetCharacterGuidByName(std::string(name));
+    if (!guid)
+        return false;
+
+    return ChallengeManager::Instance().IsHardcoreGuid(guid.GetCounter());
 }
 
-float GetHalfXPMultiplier()
+bool AreAccountBotsHardcore(std::string_view accountOrCharacter)
 {
-    return sConfigMgr->GetOption<float>("ChallengeSystem.XP.HalfMultiplier", 0.5f);
+    std::string name(accountOrCharacter);
+    uint32 accountId = AccountMgr::GetId(name);
+    if (!accountId)
+    {
+        ObjectGuid guid = sCharacterCache->GetCharacterGuidByName(name);
+        if (!guid)
+            return false;
+        accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid);
+    }
+
+    if (!accountId)
+        return false;
+
+    return ChallengeManager::Instance().IsAccountHardcore(accountId);
 }
 
-float GetQuarterXPMultiplier()
+struct BotRestrictions
+{
+    bool blockAll = false;        // NO_BOTS / SOLO_ONLY: no bots at all
+    bool hardcoreBlocked = false; // Hardcore: only Hardcore characters as bots, no random bots
+
+    bool Any() const { return blockAll || hardcoreBlocked; }
+};
+
+BotRestrictions GetBotRestrictions(Player* player)
 {
-    return sConfigMgr->GetOption<float>("ChallengeSystem.XP.QuarterMultiplier", 0.25f);
+    BotRestrictions restrictions;
+    restrictions.blockAll = ChallengeManager::Instance().HasRestriction(player, RestrictionId::NoBots) ||
+                            ChallengeManager::Instance().HasRestriction(player, RestrictionId::SoloOnly);
+    restrictions.hardcoreBlocked = ChallengeConfig::Current().hardcoreBlockPlayerBots &&
+                                   ChallengeManager::Instance().HasRestriction(player, RestrictionId::HardcoreManualGroup);
+    return restrictions;
 }
 
-uint8 GetLowQualityMaxQuality()
+// Playerbot sessions are only recognisable on cores that add WorldSession::IsBot()
+// (the playerbots branch); on other cores no chat receiver is a bot.
+template<typename Session>
+auto IsBotSession(Session const* session, int) -> decltype(session->IsBot())
 {
-    uint32 value = sConfigMgr->GetOption<uint32>("ChallengeSystem.LowQualityOnly.MaxQuality", 1);
-    return static_cast<uint8>(value);
+    return session->IsBot();
 }
 
-uint32 GetNoBuffsScanIntervalMs()
+template<typename Session>
+bool IsBotSession(Session const* /*session*/, long)
 {
-    return sConfigMgr->GetOption<uint32>("ChallengeSystem.NoBuffs.ScanIntervalMs", 1000);
+    return false;
 }
 
-bool AllowPassiveBuffs()
+bool IsPlayerbot(Player const* player)
 {
-    return sConfigMgr->GetOption<bool>("ChallengeSystem.NoBuffs.AllowPassive", true);
+    WorldSession const* session = player ? player->GetSession() : nullptr;
+    return session && IsBotSession(session, 0);
 }
 
-const std::unordered_set<uint32>& GetNoBuffsAllowList()
+// Same exemption as `.playerbots bot add`: Hardcore players may keep controlling Hardcore bots.
+bool IsRestrictedBot(Player const* target, BotRestrictions const& restrictions)
 {
-    static std::string cached;
-    static std::unordered_set<uint32> allowList;
+    if (!IsPlayerbot(target))
+        return false;
 
-    std::string current = sConfigMgr->GetOption<std::string>("ChallengeSystem.NoBuffs.AllowSpells", "");
-    if (current == cached)
-        return allowList;
+    return restrictions.blockAll || !ChallengeManager::Instance().IsHardcoreGuid(target->GetGUID().GetCounter());
+}
 
-    allowList.clear();
-    cached = current;
+// The receiver, or a group member other than the sender, that is a restricted bot.
+Player* FindRestrictedBot(Player* player, Player* receiver, Group* group, BotRestrictions const& restrictions)
+{
+    if (receiver && IsRestrictedBot(receiver, restrictions))
+        return receiver;
 
-    std::stringstream ss(current);
-    std::string token;
-    while (std::getline(ss, token, ','))
+    for (GroupReference* itr = group ? group->GetFirstMember() : nullptr; itr; itr = itr->next())
     {
-        if (auto parsed = Acore::StringTo<uint32>(token))
-            allowList.insert(*parsed);
+        Player* member = itr->GetSource();
+        if (member && member != player && IsRestrictedBot(member, restrictions))
+            return member;
     }
 
-    return allowList;
+    return nullptr;
 }
 
-bool IsQuestXPSource(uint8 xpSource)
+// Publishes to the state index and keeps the account's Hardcore count in step.
+void PublishIndexedState(Player* player, uint32 guid, uint8 tier, uint32 flags)
 {
-    return xpSource == XPSOURCE_QUEST || xpSource == XPSOURCE_QUEST_DF;
+    ChallengeStateIndex::Entry previous = ChallengeStateIndex::Instance().Publish(guid, tier, flags);
+    if (WorldSession* session = player->GetSession())
+    {
+        ChallengeAccountIndex::Instance().UpdateHardcore(session->GetAccountId(),
+            IsHardcoreState(previous.tier, previous.flags), IsHardcoreState(tier, flags));
+    }
 }
 }
 
@@ -319,15 +362,63 @@ ChallengeManager& ChallengeManager::Instance()
 
 bool ChallengeManager::IsEnabled() const
 {
-    return IsChallengeSystemEnabled();
+    return ChallengeConfig::Current().enabled;
+}
+
+char const* ChallengeManager::GetTestAuraConfigKey(RestrictionId restriction)
+{
+    return GetRestrictionDescriptor(restriction).testAuraKey;
+}
+
+uint32 ChallengeManager::GetRestrictionFlag(RestrictionId restriction)
+{
+    return GetRestrictionDescriptor(restriction).flag;
 }
 
-void ChallengeManager::OnTierStart(Player* /*player*/)
+void ChallengeManager::OnTierStart(Player* player)
 {
+    uint32 mask = GetRestrictionMask(player);
+    for (auto const& restriction : _restrictions)
+    {
+        if (mask & GetRestrictionFlag(restriction->GetRestrictionId()))
+            restriction->OnTierStart(player);
+    }
 }
 
-void ChallengeManager::OnTierEnd(Player* /*player*/)
+void ChallengeManager::OnTierEnd(Player* player)
 {
+    uint32 mask = GetRestrictionMask(player);
+    for (auto const& restriction : _restrictions)
+    {
+        if (mask & GetRestrictionFlag(restriction->GetRestrictionId()))
+            restriction->OnTierEnd(player);
+    }
+}
+
+uint32 ChallengeManager::GetRestrictionMask(Player* player)
+{
+    if (!player || !IsEnabled())
+        return 0;
+
+    return GetOrLoadState(player).restrictionMask;
+}
+
+// Calls fn for each restriction on this hook whose flag is in restrictionMask; stops at the first block.
+template<typename Fn>
+bool ChallengeManager::DispatchRestrictions(RestrictionHook hook, uint32 restrictionMask, Fn&& fn) const
+{
+    size_t index = static_cast<size_t>(hook);
+    uint32 active = restrictionMask & _hookFlags[index];
+    if (!active)
+        return true;
+
+    for (RestrictionHandler const& handler : _hookHandlers[index])
+    {
+        if ((active & handler.flag) && !fn(*handler.restriction))
+            return false;
+    }
+
+    return true;
 }
 
 void ChallengeManager::HandlePlayerLogin(Player* player)
@@ -338,74 +429,120 @@ void ChallengeManager::HandlePlayerLogin(Player* player)
     if (!IsEnabled())
         return;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    _activeStates[guid] = LoadActiveState(guid);
+    if (!player->GetSession())
+        return;
+
+    if (IsPermadead(player))
+    {
+        ApplyPermadeathLockout(player);
+        return;
+    }
+
+    GetOrLoadState(player);
 
     EnforceEquipmentRestrictions(player);
     EnforceNoTalents(player);
     EnforcePovertyCap(player);
 }
 
+void ChallengeManager::ApplyPermadeathLockout(Player* player)
+{
+    WorldSession* session = player->GetSession();
+    if (!session)
+        return;
+
+    ChatHandler(session).SendNotification(
+        ChallengeConfig::Current().GetMessage(ChallengeMessage::PermadeathLockout).c_str());
+
+    time_t now = GameTime::GetGameTime().count();
+    session->SetLogoutStartTime(now > 20 ? now - 20 : 0);
+}
+
 void ChallengeManager::HandlePlayerLogout(Player* player)
 {
     if (!player)
         return;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    _activeStates.erase(guid);
-    _permadeathPendingKick.erase(guid);
-    _permadeathCache.erase(guid);
-    _pvpDeathMarks.erase(guid);
-    _pveDeathMarks.erase(guid);
-    _noBuffsUpdateAccumulator.erase(guid);
-    _groupViolationGraceDeadline.erase(guid);
-    _groupViolationLastWarningAt.erase(guid);
+    ChallengeTimerWheel::Instance().CancelAll(player->GetGUID().GetCounter());
+
+    // Drop live-only bits (test auras) but keep the character indexed for offline checks.
+    if (ChallengePlayerState* state = GetState(player))
+    {
+        uint32 guid = player->GetGUID().GetCounter();
+        PublishIndexedState(player, guid, state->tier, state->effectiveFlags);
+        ChallengeTraceRecorder::Instance().Record(ChallengeTraceHook::StateChanged, guid, state->tier, state->effectiveFlags);
+        Group* group = player->GetGroup();
+        if (group && !group->GetGUID().IsEmpty())
+            ChallengeGroupIndex::Instance().SetMember(group->GetGUID().GetCounter(), guid, MakeGroupMember(state->tier, state->effectiveFlags));
+    }
+
+    player->CustomData.Erase(ChallengePlayerState::kDataKey);
 }
 
-uint32 ChallengeManager::EnforceEquipmentRestrictions(Player* player)
+ChallengeManager::EquipmentEnforcement ChallengeManager::EnforceEquipmentRestrictions(Player* player)
 {
+    EquipmentEnforcement result;
     if (!player)
-        return 0;
+        return result;
 
-    if (!HasRestriction(player, kRestrictionLowQualityOnly) && !HasRestriction(player, kRestrictionSelfCrafted))
-        return 0;
+    if (!HasRestriction(player, RestrictionId::LowQualityOnly) && !HasRestriction(player, RestrictionId::SelfCrafted))
+        return result;
 
-    uint32 removed = 0;
+    std::vector<uint8> violations;
     for (uint8 slot = EQUIPMENT_SLOT_START; slot < EQUIPMENT_SLOT_END; ++slot)
     {
         Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
-        if (!item)
-            continue;
+        if (item && !HandleEquipItem(player, item, slot, true))
+            violations.push_back(slot);
+    }
 
-        if (HandleEquipItem(player, item, slot, true))
-            continue;
+    if (violations.empty())
+        return result;
 
+    // Store what fits; every store uses up bag space, so each item is checked in turn.
+    std::vector<Item*> overflow;
+    for (uint8 slot : violations)
+    {
+        Item* item = player->GetItemByPos(INVENTORY_SLOT_BAG_0, slot);
         ItemPosCountVec dest;
-        InventoryResult msg = player->CanStoreItem(NULL_BAG, NULL_SLOT, dest, item, false);
-        if (msg == EQUIP_ERR_OK)
+        if (player->CanStoreItem(NULL_BAG, NULL_SLOT, dest, item, false) == EQUIP_ERR_OK)
         {
             player->RemoveItem(INVENTORY_SLOT_BAG_0, slot, true);
             player->StoreItem(dest, item, true);
-            ++removed;
+            ++result.stored;
             continue;
         }
 
-        // If inventory is full, force-unequip and mail the item so restrictions cannot be bypassed.
+        // Bags are full: force-unequip and mail the item so restrictions cannot be bypassed.
         player->MoveItemFromInventory(INVENTORY_SLOT_BAG_0, slot, true);
-        CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
-        item->DeleteFromInventoryDB(trans);
-        item->SaveToDB(trans);
+        overflow.push_back(item);
+    }
+
+    if (overflow.empty())
+        return result;
 
-        MailDraft("Challenge restriction: item unequipped",
-            "An equipped item violated active Challenge restrictions and was mailed to you because your bags were full.")
-            .AddItem(item)
-            .SendMailTo(trans, player, MailSender(player, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    for (size_t first = 0; first < overflow.size(); first += MAX_MAIL_ITEMS)
+    {
+        MailDraft draft("Challenge restriction: items unequipped",
+            "Equipped items violated active Challenge restrictions and were mailed to you because your bags were full.");
+
+        size_t last = std::min<size_t>(first + MAX_MAIL_ITEMS, overflow.size());
+        for (size_t i = first; i < last; ++i)
+        {
+            Item* item = overflow[i];
+            item->DeleteFromInventoryDB(trans);
+            item->SaveToDB(trans);
+            draft.AddItem(item);
+        }
 
-        CharacterDatabase.CommitTransaction(trans);
-        ++removed;
+        draft.SendMailTo(trans, player, MailSender(player, MAIL_STATIONERY_GM), MAIL_CHECK_MASK_COPIED);
+        ++result.mails;
     }
 
-    return removed;
+    CharacterDatabase.CommitTransaction(trans);
+    result.mailed = static_cast<uint32>(overflow.size());
+    return result;
 }
 
 void ChallengeManager::EnforceNoTalents(Player* player)
@@ -413,7 +550,7 @@ void ChallengeManager::EnforceNoTalents(Player* player)
     if (!player)
         return;
 
-    if (!HasRestriction(player, kRestrictionNoTalents))
+    if (!HasRestriction(player, RestrictionId::NoTalents))
         return;
 
     if (player->GetFreeTalentPoints() == 0)
@@ -428,11 +565,10 @@ void ChallengeManager::EnforcePovertyCap(Player* player)
     if (!player)
         return;
 
-    if (!HasRestriction(player, kRestrictionPoverty))
+    if (!HasRestriction(player, RestrictionId::Poverty))
         return;
 
-    uint8 tier = GetActiveTier(player);
-    uint32 cap = GetPovertyGoldCap(tier);
+    uint32 cap = ChallengeConfig::Current().GetPovertyGoldCap(GetActiveTier(player));
     if (cap == 0)
         return;
 
@@ -440,94 +576,190 @@ void ChallengeManager::EnforcePovertyCap(Player* player)
         player->SetMoney(cap);
 }
 
-void ChallengeManager::HandlePlayerUpdate(Player* player, uint32 diff)
+void ChallengeManager::HandlePlayerUpdate(Player* player, uint32 /*diff*/)
 {
     if (!player)
         return;
 
-    uint32 guid = player->GetGUID().GetCounter();
-
     if (!IsEnabled())
     {
-        _noBuffsUpdateAccumulator.erase(guid);
-        _groupViolationGraceDeadline.erase(guid);
-        _groupViolationLastWarningAt.erase(guid);
+        if (ChallengePlayerState* state = GetState(player))
+        {
+            ChallengeTimerWheel::Instance().CancelAll(player->GetGUID().GetCounter());
+            state->noMountsActive = false;
+            state->dismountPending = false;
+            state->noBuffsActive = false;
+            state->pendingBuffRemovals.clear();
+            state->ClearGroupGrace();
+        }
         return;
     }
 
-    if (HasRestriction(player, kRestrictionNoMounts))
+    ChallengePlayerState& state = GetOrLoadState(player);
+    if (state.testAurasDirty || state.testAuraGeneration != ChallengeConfig::Current().generation)
+        RefreshTestAuraFlags(player, state);
+
+    // Mount casts are refused up front (HandleMountCast); this only reconciles
+    // mounts that predate the restriction or were applied without a cast.
+    bool noMounts = HasRestriction(state, RestrictionId::NoMounts);
+    if (noMounts != state.noMountsActive)
     {
-        if (player->IsMounted())
-            player->Dismount();
+        state.noMountsActive = noMounts;
+        state.dismountPending = noMounts;
     }
 
-    Group* group = player->GetGroup();
-    bool invalidManualGroup = group && !group->isLFGGroup() && !HandleGroupAccept(player, group);
-    if (!invalidManualGroup)
+    if (state.dismountPending)
     {
-        _groupViolationGraceDeadline.erase(guid);
-        _groupViolationLastWarningAt.erase(guid);
+        state.dismountPending = false;
+        if (noMounts && player->IsMounted())
+            Dismount(player);
     }
-    else
+
+    RefreshGroupValidity(player, state);
+
+    bool noBuffs = HasRestriction(state, RestrictionId::NoBuffs);
+    if (noBuffs != state.noBuffsActive)
     {
-        uint32 gracePeriod = GetGroupGracePeriodSeconds();
-        if (gracePeriod == 0)
+        state.noBuffsActive = noBuffs;
+        uint32 guid = player->GetGUID().GetCounter();
+        if (noBuffs)
         {
-            player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
-            SendMessage(player, "ChallengeSystem.Message.GroupBlocked",
-                "Grouping is disabled by active Challenge restrictions.");
-            _groupViolationGraceDeadline.erase(guid);
-            _groupViolationLastWarningAt.erase(guid);
+            // Buffs that landed before the restriction did; new ones are caught by HandleAuraApply.
+            RemoveForbiddenBuffs(player);
+            if (uint32 interval = ChallengeConfig::Current().noBuffsScanIntervalMs)
+                ChallengeTimerWheel::Instance().Schedule(guid, ChallengeTimer::NoBuffsScan, interval);
         }
         else
         {
-            uint32 now = GameTime::GetGameTime().count();
-            uint32& deadline = _groupViolationGraceDeadline[guid];
-            uint32& lastWarnAt = _groupViolationLastWarningAt[guid];
-
-            if (deadline == 0 || now > deadline)
-            {
-                deadline = now + gracePeriod;
-                lastWarnAt = 0;
-            }
-
-            if (now >= deadline)
-            {
-                player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
-                SendMessage(player, "ChallengeSystem.Message.GroupBlocked",
-                    "Grouping is disabled by active Challenge restrictions.");
-                _groupViolationGraceDeadline.erase(guid);
-                _groupViolationLastWarningAt.erase(guid);
-            }
-            else if ((lastWarnAt == 0 || now - lastWarnAt >= 10) && player->GetSession())
-            {
-                ChatHandler(player->GetSession()).SendSysMessage(
-                    Acore::StringFormat("Challenge restriction: leave your group within {} seconds or you will be removed.",
-                        deadline - now).c_str());
-                lastWarnAt = now;
-            }
+            ChallengeTimerWheel::Instance().Cancel(guid, ChallengeTimer::NoBuffsScan);
         }
     }
 
-    if (!HasRestriction(player, kRestrictionNoBuffs))
+    if (!state.pendingBuffRemovals.empty())
     {
-        _noBuffsUpdateAccumulator.erase(guid);
+        std::vector<uint32> spells;
+        spells.swap(state.pendingBuffRemovals);
+        if (noBuffs)
+        {
+            for (uint32 spellId : spells)
+                player->RemoveAura(spellId);
+        }
+    }
+}
+
+void ChallengeManager::HandleAuraApply(Player* player, Aura* aura)
+{
+    if (!player || !aura)
         return;
+
+    if (!IsEnabled())
+        return;
+
+    ChallengePlayerState* state = GetState(player);
+    if (!state)
+        return;
+
+    uint32 spellId = aura->GetId();
+    if (IsTestAura(ChallengeConfig::Current(), spellId))
+        state->testAurasDirty = true;
+
+    // Removing inside the apply path would pull the aura out from under its caller;
+    // both cases are resolved on the owner's next update.
+    ChallengeSpellTable const& spells = ChallengeSpellTable::Current();
+    if (spells.Has(spellId, ChallengeSpellClass::Mount) && HasRestriction(*state, RestrictionId::NoMounts))
+        state->dismountPending = true;
+
+    if (spells.IsForbiddenBuff(spellId) && HasRestriction(*state, RestrictionId::NoBuffs))
+        state->pendingBuffRemovals.push_back(spellId);
+}
+
+void ChallengeManager::HandleAuraRemove(Player* player, Aura* aura)
+{
+    if (!player || !aura)
+        return;
+
+    if (!IsTestAura(ChallengeConfig::Current(), aura->GetId()))
+        return;
+
+    if (ChallengePlayerState* state = GetState(player))
+        state->testAurasDirty = true;
+}
+
+void ChallengeManager::UpdateTimers(uint32 diff)
+{
+    std::vector<ChallengeTimerWheel::Expired> expired;
+    ChallengeTimerWheel::Instance().Update(diff, expired);
+
+    for (ChallengeTimerWheel::Expired const& timer : expired)
+    {
+        if (Player* player = ObjectAccessor::FindPlayerByLowGUID(timer.guid))
+            HandleTimer(player, timer.timer);
     }
+}
 
-    uint32& accumulator = _noBuffsUpdateAccumulator[guid];
-    accumulator = (accumulator > 60000 ? 60000 : accumulator) + diff;
-    uint32 interval = GetNoBuffsScanIntervalMs();
-    if (interval == 0)
-        interval = 1000;
+void ChallengeManager::HandleTimer(Player* player, ChallengeTimer timer)
+{
+    if (timer == ChallengeTimer::PermadeathKick)
+    {
+        if (WorldSession* session = player->GetSession())
+        {
+            time_t now = GameTime::GetGameTime().count();
+            session->SetLogoutStartTime(now > 20 ? now - 20 : 0);
+            ClearPermadeathPending(player);
+        }
+        return;
+    }
 
-    if (accumulator < interval)
+    ChallengePlayerState* state = GetState(player);
+    if (!state)
         return;
 
-    accumulator = 0;
+    switch (timer)
+    {
+        case ChallengeTimer::GroupGrace:
+        {
+            if (!state->groupInvalidSince || !player->GetGroup())
+                return;
 
-    const auto& allowList = GetNoBuffsAllowList();
-    bool allowPassive = AllowPassiveBuffs();
+            ChallengeTimerWheel::Instance().Cancel(player->GetGUID().GetCounter(), ChallengeTimer::GroupWarning);
+            player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
+            SendMessage(player, ChallengeMessage::GroupBlocked);
+            state->ClearGroupGrace();
+            break;
+        }
+        case ChallengeTimer::GroupWarning:
+        {
+            if (!state->groupInvalidSince)
+                return;
+
+            uint32 deadline = state->groupInvalidSince + ChallengeConfig::Current().groupGracePeriodSeconds;
+            uint32 now = GameTime::GetGameTime().count();
+            if (now >= deadline)
+                return;
+
+            SendGroupWarning(player, deadline - now);
+            ChallengeTimerWheel::Instance().Schedule(player->GetGUID().GetCounter(), ChallengeTimer::GroupWarning,
+                kGroupWarningIntervalSeconds * IN_MILLISECONDS);
+            break;
+        }
+        case ChallengeTimer::NoBuffsScan:
+        {
+            if (!state->noBuffsActive)
+                return;
+
+            RemoveForbiddenBuffs(player);
+            if (uint32 interval = ChallengeConfig::Current().noBuffsScanIntervalMs)
+                ChallengeTimerWheel::Instance().Schedule(player->GetGUID().GetCounter(), ChallengeTimer::NoBuffsScan, interval);
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+void ChallengeManager::RemoveForbiddenBuffs(Player* player)
+{
+    ChallengeSpellTable const& spells = ChallengeSpellTable::Current();
 
     std::vector<uint32> toRemove;
     Unit::AuraApplicationMap const& auras = player->GetAppliedAuras();
@@ -543,20 +775,8 @@ void ChallengeManager::HandlePlayerUpdate(Player* player, uint32 diff)
         if (!aura)
             continue;
 
-        SpellInfo const* spellInfo = aura->GetSpellInfo();
-        if (!spellInfo)
-            continue;
-
-        if (!spellInfo->IsPositive())
-            continue;
-
-        if (allowPassive && spellInfo->IsPassive())
-            continue;
-
-        if (allowList.find(spellInfo->Id) != allowList.end())
-            continue;
-
-        toRemove.push_back(spellInfo->Id);
+        if (spells.IsForbiddenBuff(aura->GetId()))
+            toRemove.push_back(aura->GetId());
     }
 
     for (uint32 spellId : toRemove)
@@ -568,7 +788,7 @@ void ChallengeManager::HandleTalentPoints(Player* player, uint32& points)
     if (!player)
         return;
 
-    if (!HasRestriction(player, kRestrictionNoTalents))
+    if (!HasRestriction(player, RestrictionId::NoTalents))
         return;
 
     points = 0;
@@ -582,23 +802,28 @@ void ChallengeManager::HandleGiveXP(Player* player, uint32& amount, uint8 xpSour
     if (amount == 0)
         return;
 
-    if (HasRestriction(player, kRestrictionOnlyQuestXP) && !IsQuestXPSource(xpSource))
+    if (!IsEnabled())
+        return;
+
+    ChallengePlayerState const& state = GetOrLoadState(player);
+
+    if (HasRestriction(state, RestrictionId::OnlyQuestXP) && !IsQuestXPSource(xpSource))
     {
         amount = 0;
         return;
     }
 
-    if (HasRestriction(player, kRestrictionNoQuestXP) && IsQuestXPSource(xpSource))
+    if (HasRestriction(state, RestrictionId::NoQuestXP) && IsQuestXPSource(xpSource))
     {
         amount = 0;
         return;
     }
 
     float multiplier = 1.0f;
-    if (HasRestriction(player, kRestrictionQuarterXP))
-        multiplier = GetQuarterXPMultiplier();
-    else if (HasRestriction(player, kRestrictionHalfXP))
-        multiplier = GetHalfXPMultiplier();
+    if (HasRestriction(state, RestrictionId::QuarterXP))
+        multiplier = ChallengeConfig::Current().quarterXPMultiplier;
+    else if (HasRestriction(state, RestrictionId::HalfXP))
+        multiplier = ChallengeConfig::Current().halfXPMultiplier;
 
     if (multiplier < 0.0f)
         multiplier = 0.0f;
@@ -611,7 +836,7 @@ void ChallengeManager::HandleQuestXP(Player* player, uint32& xpValue)
     if (!player)
         return;
 
-    if (!HasRestriction(player, kRestrictionNoQuestXP))
+    if (!HasRestriction(player, RestrictionId::NoQuestXP))
         return;
 
     xpValue = 0;
@@ -625,11 +850,10 @@ void ChallengeManager::HandleMoneyChange(Player* player, int32& amount)
     if (amount <= 0)
         return;
 
-    if (!HasRestriction(player, kRestrictionPoverty))
+    if (!HasRestriction(player, RestrictionId::Poverty))
         return;
 
-    uint8 tier = GetActiveTier(player);
-    uint32 cap = GetPovertyGoldCap(tier);
+    uint32 cap = ChallengeConfig::Current().GetPovertyGoldCap(GetActiveTier(player));
     if (cap == 0)
         return;
 
@@ -650,61 +874,231 @@ bool ChallengeManager::HandleEquipItem(Player* player, Item* item, uint8 /*slot*
     if (!player || !item)
         return true;
 
-    if (HasRestriction(player, kRestrictionLowQualityOnly))
+    return DispatchRestrictions(RestrictionHook::EquipItem, GetRestrictionMask(player),
+        [player, item](ChallengeRestriction& restriction) { return restriction.OnEquipItem(player, item); });
+}
+
+bool ChallengeManager::HandleGuildBankAccess(Player* player)
+{
+    if (!player)
+        return true;
+
+    return DispatchRestrictions(RestrictionHook::GuildBank, GetRestrictionMask(player),
+        [player](ChallengeRestriction& restriction) { return restriction.OnGuildBankAccess(player); });
+}
+
+void ChallengeManager::RegisterRestriction(std::shared_ptr<ChallengeRestriction> restriction)
+{
+    if (!restriction)
+        return;
+
+    uint32 flag = GetRestrictionFlag(restriction->GetRestrictionId());
+    uint32 hooks = restriction->GetHooks();
+    for (size_t i = 0; i < kRestrictionHookCount; ++i)
     {
-        ItemTemplate const* proto = item->GetTemplate();
-        if (!proto || proto->Quality > GetLowQualityMaxQuality())
-            return false;
+        if (!(hooks & RestrictionHookMask(static_cast<RestrictionHook>(i))))
+            continue;
+
+        _hookHandlers[i].push_back({ flag, restriction.get() });
+        _hookFlags[i] |= flag;
     }
 
-    if (HasRestriction(player, kRestrictionSelfCrafted))
+    _restrictions.push_back(std::move(restriction));
+}
+
+ChallengeManager::ActiveState ChallengeManager::LoadActiveState(uint32 guid) const
+{
+    ChallengeStateIndex::Entry entry;
+    if (!ChallengeStateIndex::Instance().Find(guid, entry))
+        return {};
+
+    return MakeActiveState(entry.tier, entry.flags);
+}
+
+ChallengeManager::ActiveState ChallengeManager::MakeActiveState(uint8 tier, uint32 flags)
+{
+    ActiveState state;
+    state.tier = tier > kTierMax ? 0 : tier;
+    state.flags = flags;
+    return state;
+}
+
+ChallengePlayerState* ChallengeManager::GetState(Player* player) const
+{
+    return player->CustomData.Get<ChallengePlayerState>(ChallengePlayerState::kDataKey);
+}
+
+ChallengePlayerState& ChallengeManager::GetOrLoadState(Player* player)
+{
+    if (ChallengePlayerState* state = GetState(player))
+        return *state;
+
+    ChallengePlayerState* state = player->CustomData.GetDefault<ChallengePlayerState>(ChallengePlayerState::kDataKey);
+    ActiveState loaded = LoadActiveState(player->GetGUID().GetCounter());
+    state->SetTierFlags(loaded.tier, loaded.flags);
+    PublishState(player, *state);
+    return *state;
+}
+
+void ChallengeManager::PublishState(Player* player, ChallengePlayerState const& state) const
+{
+    uint32 guid = player->GetGUID().GetCounter();
+    PublishIndexedState(player, guid, state.tier, state.GetPublishedFlags());
+    ChallengeTraceRecorder::Instance().Record(ChallengeTraceHook::StateChanged, guid, state.tier, state.GetPublishedFlags());
+
+    // Members cache their group validity; a changed summary makes them re-evaluate.
+    Group* group = player->GetGroup();
+    if (group && !group->GetGUID().IsEmpty())
     {
-        // Missing creator GUID means the item wasn't crafted by this character.
-        if (item->GetGuidValue(ITEM_FIELD_CREATOR) != player->GetGUID())
-            return false;
+        ChallengeGroupIndex::Instance().SetMember(group->GetGUID().GetCounter(), guid,
+            MakeGroupMember(state.tier, state.GetPublishedFlags()));
     }
+}
 
-    return true;
+ChallengeGroupMember ChallengeManager::GetGroupMember(uint32 guid) const
+{
+    ChallengeStateIndex::Entry entry;
+    if (!ChallengeStateIndex::Instance().Find(guid, entry))
+        return ChallengeGroupMember();
+
+    return MakeGroupMember(entry.tier, entry.flags);
 }
 
-bool ChallengeManager::HandleGuildBankAccess(Player* player)
+void ChallengeManager::SeedGroupSummary(Group* group) const
 {
-    if (!player)
-        return true;
+    // A group still being formed has no guid yet and must not share index entry 0.
+    if (!group || group->GetGUID().IsEmpty())
+        return;
 
-    if (HasRestriction(player, kRestrictionNoGuildBank))
-        return false;
+    std::vector<std::pair<uint32, ChallengeGroupMember>> members;
+    for (Group::MemberSlot const& slot : group->GetMemberSlots())
+    {
+        uint32 memberGuid = slot.guid.GetCounter();
+        members.emplace_back(memberGuid, GetGroupMember(memberGuid));
+    }
 
-    return true;
+    ChallengeGroupIndex::Instance().Seed(group->GetGUID().GetCounter(), members);
 }
 
-void ChallengeManager::RegisterRestriction(std::shared_ptr<ChallengeRestriction> restriction)
+void ChallengeManager::HandleGroupMemberAdded(Group* group, uint32 memberGuid) const
 {
-    _restrictions.push_back(restriction);
+    if (!group || group->GetGUID().IsEmpty())
+        return;
+
+    ChallengeGroupIndex::Instance().SetMember(group->GetGUID().GetCounter(), memberGuid, GetGroupMember(memberGuid));
 }
 
-ChallengeManager::ActiveState ChallengeManager::LoadActiveState(uint32 guid)
+bool ChallengeManager::GetGroupSummary(Group* group, uint32 excludeGuid, ChallengeGroupSummary& out) const
 {
-    ActiveState state;
-    uint32 tier = GetSettingUInt(guid, kSettingTierSource);
-    uint32 flags = GetSettingUInt(guid, kSettingFlagsSource);
+    // Not indexed until it has a guid; its few members are counted directly.
+    if (group->GetGUID().IsEmpty())
+    {
+        out = ChallengeGroupSummary();
+        for (Group::MemberSlot const& slot : group->GetMemberSlots())
+        {
+            uint32 memberGuid = slot.guid.GetCounter();
+            if (memberGuid != excludeGuid)
+                out.Add(GetGroupMember(memberGuid));
+        }
 
-    if (tier > kTierMax)
-        tier = 0;
+        // Before creation the leader is not yet in the member list.
+        uint32 leaderGuid = group->GetLeaderGUID().GetCounter();
+        if (group->GetMemberSlots().empty() && leaderGuid && leaderGuid != excludeGuid)
+            out.Add(GetGroupMember(leaderGuid));
 
-    state.tier = static_cast<uint8>(tier);
-    state.flags = flags;
-    return state;
+        return true;
+    }
+
+    uint32 groupGuid = group->GetGUID().GetCounter();
+    if (ChallengeGroupIndex::Instance().GetSummary(groupGuid, excludeGuid, out))
+        return true;
+
+    // Groups loaded at startup have seen no GroupScript event yet.
+    SeedGroupSummary(group);
+    return ChallengeGroupIndex::Instance().GetSummary(groupGuid, excludeGuid, out);
 }
 
-ChallengeManager::ActiveState& ChallengeManager::GetOrLoadActiveState(uint32 guid)
+void ChallengeManager::RefreshGroupValidity(Player* player, ChallengePlayerState& state)
 {
-    auto itr = _activeStates.find(guid);
-    if (itr != _activeStates.end())
-        return itr->second;
+    Group* group = player->GetGroup();
+    if (!group)
+    {
+        if (state.groupInvalidSince)
+            CancelGroupGrace(player, state);
+        if (state.groupGuid)
+            state.ClearGroupGrace();
+        return;
+    }
 
-    auto result = _activeStates.emplace(guid, LoadActiveState(guid));
-    return result.first->second;
+    // Read the version before evaluating so a concurrent change forces another pass.
+    uint32 groupGuid = group->GetGUID().GetCounter();
+    uint32 version = ChallengeGroupIndex::Instance().GetVersion(groupGuid);
+    // LFG conversion of an existing group fires no GroupScript hook, so it is part of the key.
+    bool lfg = group->isLFGGroup();
+    if (groupGuid == state.groupGuid && version == state.groupVersion && lfg == state.groupLfg)
+        return;
+
+    state.groupGuid = groupGuid;
+    state.groupVersion = version;
+    state.groupLfg = lfg;
+
+    bool invalid = !lfg && !HandleGroupAccept(player, group);
+    if (!invalid)
+    {
+        if (state.groupInvalidSince)
+            CancelGroupGrace(player, state);
+        return;
+    }
+
+    if (state.groupInvalidSince)
+        return;
+
+    uint32 gracePeriod = ChallengeConfig::Current().groupGracePeriodSeconds;
+    if (gracePeriod == 0)
+    {
+        player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
+        SendMessage(player, ChallengeMessage::GroupBlocked);
+        state.ClearGroupGrace();
+        return;
+    }
+
+    state.groupInvalidSince = GameTime::GetGameTime().count();
+    SendGroupWarning(player, gracePeriod);
+
+    uint32 guid = player->GetGUID().GetCounter();
+    ChallengeTimerWheel::Instance().Schedule(guid, ChallengeTimer::GroupGrace, gracePeriod * IN_MILLISECONDS);
+    ChallengeTimerWheel::Instance().Schedule(guid, ChallengeTimer::GroupWarning, kGroupWarningIntervalSeconds * IN_MILLISECONDS);
+}
+
+void ChallengeManager::CancelGroupGrace(Player* player, ChallengePlayerState& state)
+{
+    uint32 guid = player->GetGUID().GetCounter();
+    ChallengeTimerWheel::Instance().Cancel(guid, ChallengeTimer::GroupGrace);
+    ChallengeTimerWheel::Instance().Cancel(guid, ChallengeTimer::GroupWarning);
+    state.groupInvalidSince = 0;
+}
+
+void ChallengeManager::RefreshTestAuraFlags(Player* player, ChallengePlayerState& state) const
+{
+    ChallengeConfig const& config = ChallengeConfig::Current();
+    state.testAurasDirty = false;
+    state.testAuraGeneration = config.generation;
+
+    uint32 auraFlags = 0;
+    if (config.hasTestAuras)
+    {
+        for (RestrictionDescriptor const& descriptor : kRestrictionDescriptors)
+        {
+            if (HasTestAura(player, config, descriptor.id))
+                auraFlags |= descriptor.flag;
+        }
+    }
+
+    if (auraFlags == state.testAuraFlags)
+        return;
+
+    state.SetTestAuraFlags(auraFlags);
+    PublishState(player, state);
 }
 
 uint8 ChallengeManager::GetActiveTier(Player* player)
@@ -712,8 +1106,7 @@ uint8 ChallengeManager::GetActiveTier(Player* player)
     if (!player)
         return 0;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    return GetOrLoadActiveState(guid).tier;
+    return GetOrLoadState(player).tier;
 }
 
 uint32 ChallengeManager::GetActiveFlags(Player* player)
@@ -721,11 +1114,7 @@ uint32 ChallengeManager::GetActiveFlags(Player* player)
     if (!player)
         return 0;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    ActiveState& state = GetOrLoadActiveState(guid);
-    if (state.tier == 0)
-        return 0;
-    return state.flags;
+    return GetOrLoadState(player).effectiveFlags;
 }
 
 void ChallengeManager::SetActiveTierFlags(Player* player, uint8 tier, uint32 flags)
@@ -736,10 +1125,11 @@ void ChallengeManager::SetActiveTierFlags(Player* player, uint8 tier, uint32 fla
     if (tier > kTierMax)
         tier = 0;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    SetSettingUInt(guid, kSettingTierSource, tier);
-    SetSettingUInt(guid, kSettingFlagsSource, flags);
-    _activeStates[guid] = { tier, flags };
+    ChallengeWriteQueue::Instance().QueueState(player->GetGUID().GetCounter(), tier, flags, GameTime::GetGameTime().count());
+
+    ChallengePlayerState& state = GetOrLoadState(player);
+    state.SetTierFlags(tier, flags);
+    PublishState(player, state);
 
     if (tier > 0 && (flags & FLAG_HARDCORE))
         TryAutoJoinHardcoreGuild(player);
@@ -758,21 +1148,7 @@ bool ChallengeManager::IsPermadead(Player* player)
     if (!IsEnabled())
         return false;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    if (_permadeathCache.find(guid) != _permadeathCache.end())
-        return true;
-
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT is_dead FROM ip_permadeath WHERE guid = {} LIMIT 1", guid);
-    if (!result)
-        return false;
-
-    Field* fields = result->Fetch();
-    if (fields[0].Get<uint8>() == 0)
-        return false;
-
-    _permadeathCache.insert(guid);
-    return true;
+    return ChallengePermadeathIndex::Instance().Contains(player->GetGUID().GetCounter());
 }
 
 bool ChallengeManager::IsPermadeathPending(Player* player) const
@@ -783,29 +1159,28 @@ bool ChallengeManager::IsPermadeathPending(Player* player) const
     if (!IsEnabled())
         return false;
 
-    uint32 guid = player->GetGUID().GetCounter();
-    return _permadeathPendingKick.find(guid) != _permadeathPendingKick.end();
+    ChallengePlayerState const* state = GetState(player);
+    return state && state->permadeathPending;
 }
 
-void ChallengeManager::ClearPermadeathPending(uint32 guid)
+void ChallengeManager::ClearPermadeathPending(Player* player)
 {
-    _permadeathPendingKick.erase(guid);
+    if (!player)
+        return;
+
+    if (ChallengePlayerState* state = GetState(player))
+        state->permadeathPending = false;
 }
 
-bool ChallengeManager::IsHardcoreGuid(uint32 guid)
+bool ChallengeManager::IsHardcoreGuid(uint32 guid) const
 {
-    auto itr = _activeStates.find(guid);
-    if (itr != _activeStates.end())
-    {
-        if (itr->second.tier == 0)
-            return false;
-        return (itr->second.flags & FLAG_HARDCORE) != 0;
-    }
-
     ActiveState state = LoadActiveState(guid);
-    if (state.tier == 0)
-        return false;
-    return (state.flags & FLAG_HARDCORE) != 0;
+    return IsHardcoreState(state.tier, state.flags);
+}
+
+bool ChallengeManager::IsAccountHardcore(uint32 accountId) const
+{
+    return ChallengeAccountIndex::Instance().IsHardcore(accountId);
 }
 
 void ChallengeManager::RecordPvPDeath(Player* killed)
@@ -813,7 +1188,7 @@ void ChallengeManager::RecordPvPDeath(Player* killed)
     if (!killed)
         return;
 
-    _pvpDeathMarks[killed->GetGUID().GetCounter()] = GameTime::GetGameTime().count();
+    GetOrLoadState(killed).pvpDeathMark = GameTime::GetGameTime().count();
 }
 
 void ChallengeManager::RecordPvEDeath(Player* killed)
@@ -821,10 +1196,10 @@ void ChallengeManager::RecordPvEDeath(Player* killed)
     if (!killed)
         return;
 
-    _pveDeathMarks[killed->GetGUID().GetCounter()] = GameTime::GetGameTime().count();
+    GetOrLoadState(killed).pveDeathMark = GameTime::GetGameTime().count();
 }
 
-bool ChallengeManager::HasRestriction(Player* player, const std::string& restrictionId)
+bool ChallengeManager::HasRestriction(Player* player, RestrictionId restriction)
 {
     if (!player)
         return false;
@@ -832,121 +1207,32 @@ bool ChallengeManager::HasRestriction(Player* player, const std::string& restric
     if (!IsEnabled())
         return false;
 
-    uint32 flags = GetActiveFlags(player);
+    return HasRestriction(GetOrLoadState(player), restriction);
+}
 
-    if (restrictionId == kRestrictionHardcoreManualGroup)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.Hardcore"))
-            return true;
-        return (flags & FLAG_HARDCORE) != 0;
-    }
-    if (restrictionId == kRestrictionSoloOnly)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.SoloOnly"))
-            return true;
-        return (flags & FLAG_SOLO_ONLY) != 0;
-    }
-    if (restrictionId == kRestrictionNoTrade)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoTrade"))
-            return true;
-        return (flags & FLAG_NO_TRADE) != 0;
-    }
-    if (restrictionId == kRestrictionNoMail)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoMail"))
-            return true;
-        return (flags & FLAG_NO_MAIL) != 0;
-    }
-    if (restrictionId == kRestrictionNoAuction)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoAuction"))
-            return true;
-        return (flags & FLAG_NO_AUCTION) != 0;
-    }
-    if (restrictionId == kRestrictionNoSummons)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoSummons"))
-            return true;
-        return (flags & FLAG_NO_SUMMONS) != 0;
-    }
-    if (restrictionId == kRestrictionPermadeath)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.Permadeath"))
-            return true;
-        return (flags & FLAG_PERMADEATH) != 0;
-    }
-    if (restrictionId == kRestrictionLowQualityOnly)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.LowQualityOnly"))
-            return true;
-        return (flags & FLAG_LOW_QUALITY_ONLY) != 0;
-    }
-    if (restrictionId == kRestrictionSelfCrafted)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.SelfCrafted"))
-            return true;
-        return (flags & FLAG_SELF_CRAFTED) != 0;
-    }
-    if (restrictionId == kRestrictionPoverty)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.Poverty"))
-            return true;
-        return (flags & FLAG_POVERTY) != 0;
-    }
-    if (restrictionId == kRestrictionNoGuildBank)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoGuildBank"))
-            return true;
-        return (flags & FLAG_NO_GUILD_BANK) != 0;
-    }
-    if (restrictionId == kRestrictionNoMounts)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoMounts"))
-            return true;
-        return (flags & FLAG_NO_MOUNTS) != 0;
-    }
-    if (restrictionId == kRestrictionNoBuffs)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoBuffs"))
-            return true;
-        return (flags & FLAG_NO_BUFFS) != 0;
-    }
-    if (restrictionId == kRestrictionNoTalents)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoTalents"))
-            return true;
-        return (flags & FLAG_NO_TALENTS) != 0;
-    }
-    if (restrictionId == kRestrictionNoQuestXP)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoQuestXP"))
-            return true;
-        return (flags & FLAG_NO_QUEST_XP) != 0;
-    }
-    if (restrictionId == kRestrictionOnlyQuestXP)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.OnlyQuestXP"))
-            return true;
-        return (flags & FLAG_ONLY_QUEST_XP) != 0;
-    }
-    if (restrictionId == kRestrictionHalfXP)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.HalfXP"))
-            return true;
-        return (flags & FLAG_HALF_XP) != 0;
-    }
-    if (restrictionId == kRestrictionQuarterXP)
-    {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.QuarterXP"))
-            return true;
-        return (flags & FLAG_QUARTER_XP) != 0;
-    }
-    if (restrictionId == kRestrictionNoBots)
+bool ChallengeManager::HasRestrictionByGuid(uint32 guid, RestrictionId restriction) const
+{
+    if (!IsEnabled())
+        return false;
+
+    ChallengeStateIndex::Entry entry;
+    if (!ChallengeStateIndex::Instance().Find(guid, entry))
+        return false;
+
+    return (entry.flags & GetRestrictionDescriptor(restriction).flag) != 0;
+}
+
+bool ChallengeManager::HasRestriction(ChallengePlayerState const& state, RestrictionId restriction)
+{
+    return (state.restrictionMask & GetRestrictionDescriptor(restriction).flag) != 0;
+}
+
+bool ChallengeManager::HasRestriction(Player* player, const std::string& restrictionId)
+{
+    for (RestrictionDescriptor const& descriptor : kRestrictionDescriptors)
     {
-        if (HasTestAura(player, "ChallengeSystem.TestAura.NoBots"))
-            return true;
-        return (flags & FLAG_NO_BOTS) != 0;
+        if (restrictionId == descriptor.name)
+            return HasRestriction(player, descriptor.id);
     }
 
     return false;
@@ -957,10 +1243,12 @@ bool ChallengeManager::HandleTradeAttempt(Player* player, Player* target)
     if (!player)
         return true;
 
-    if (HasRestriction(player, kRestrictionNoTrade))
+    if (!DispatchRestrictions(RestrictionHook::Trade, GetRestrictionMask(player),
+        [player, target](ChallengeRestriction& restriction) { return restriction.OnTradeAttempt(player, target); }))
         return false;
 
-    if (target && HasRestriction(target, kRestrictionNoTrade))
+    if (target && !DispatchRestrictions(RestrictionHook::Trade, GetRestrictionMask(target),
+        [player, target](ChallengeRestriction& restriction) { return restriction.OnTradeAttempt(target, player); }))
         return false;
 
     return true;
@@ -971,10 +1259,21 @@ bool ChallengeManager::HandleMailSend(Player* player)
     if (!player)
         return true;
 
-    if (HasRestriction(player, kRestrictionNoMail))
-        return false;
+    return DispatchRestrictions(RestrictionHook::MailSend, GetRestrictionMask(player),
+        [player](ChallengeRestriction& restriction) { return restriction.OnMailSend(player); });
+}
 
-    return true;
+bool ChallengeManager::HandleMailReceive(uint32 receiverGuid) const
+{
+    if (!IsEnabled())
+        return true;
+
+    ChallengeStateIndex::Entry entry;
+    if (!ChallengeStateIndex::Instance().Find(receiverGuid, entry))
+        return true;
+
+    return DispatchRestrictions(RestrictionHook::MailReceive, entry.flags,
+        [receiverGuid](ChallengeRestriction& restriction) { return restriction.OnMailReceive(receiverGuid); });
 }
 
 bool ChallengeManager::HandleAuctionAction(Player* player)
@@ -982,10 +1281,8 @@ bool ChallengeManager::HandleAuctionAction(Player* player)
     if (!player)
         return true;
 
-    if (HasRestriction(player, kRestrictionNoAuction))
-        return false;
-
-    return true;
+    return DispatchRestrictions(RestrictionHook::Auction, GetRestrictionMask(player),
+        [player](ChallengeRestriction& restriction) { return restriction.OnAuctionAction(player); });
 }
 
 bool ChallengeManager::HandleGroupInvite(Player* player, Player* target)
@@ -993,16 +1290,23 @@ bool ChallengeManager::HandleGroupInvite(Player* player, Player* target)
     if (!player || !target)
         return true;
 
-    if (HasRestriction(player, kRestrictionSoloOnly) || HasRestriction(target, kRestrictionSoloOnly))
-        return false;
+    if (!IsEnabled())
+        return true;
 
-    bool playerHardcore = HasRestriction(player, kRestrictionHardcoreManualGroup);
-    bool targetHardcore = HasRestriction(target, kRestrictionHardcoreManualGroup);
+    // The target may be updated by another map thread; read it from the index.
+    ChallengeGroupMember joiner = GetGroupMember(target->GetGUID().GetCounter());
 
-    if (playerHardcore != targetHardcore)
-        return false;
+    // The target joins the inviter's whole group, or just the inviter.
+    ChallengeGroupSummary others;
+    Group* group = player->GetGroup();
+    if (!group || !GetGroupSummary(group, 0, others))
+    {
+        ChallengePlayerState const& state = GetOrLoadState(player);
+        others = ChallengeGroupSummary();
+        others.Add(MakeGroupMember(state.tier, state.restrictionMask));
+    }
 
-    return true;
+    return IsGroupCompatible(joiner, others);
 }
 
 bool ChallengeManager::HandleGroupAccept(Player* player, Group* group)
@@ -1010,48 +1314,26 @@ bool ChallengeManager::HandleGroupAccept(Player* player, Group* group)
     if (!player || !group)
         return true;
 
-    if (group->isLFGGroup())
-    {
-        if (HasRestriction(player, kRestrictionSoloOnly) && !ShouldAllowSoloLfg())
-            return false;
-        if (HasRestriction(player, kRestrictionHardcoreManualGroup) && !ShouldAllowHardcoreLfg())
-            return false;
-
-        for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
-        {
-            Player* member = ref->GetSource();
-            if (!member)
-                continue;
-
-            if (HasRestriction(member, kRestrictionSoloOnly) && !ShouldAllowSoloLfg())
-                return false;
-            if (HasRestriction(member, kRestrictionHardcoreManualGroup) && !ShouldAllowHardcoreLfg())
-                return false;
-        }
-
+    if (!IsEnabled())
         return true;
-    }
 
-    if (HasRestriction(player, kRestrictionSoloOnly))
+    ChallengePlayerState const& state = GetOrLoadState(player);
+    ChallengeGroupMember joiner = MakeGroupMember(state.tier, state.restrictionMask);
+    if (joiner.soloOnly && !group->isLFGGroup())
         return false;
 
-    bool playerHardcore = HasRestriction(player, kRestrictionHardcoreManualGroup);
+    // Other members may be updated by other map threads; their counts come from the summary.
+    ChallengeGroupSummary others;
+    if (!GetGroupSummary(group, player->GetGUID().GetCounter(), others))
+        return true;
 
-    for (GroupReference* ref = group->GetFirstMember(); ref; ref = ref->next())
+    if (group->isLFGGroup())
     {
-        Player* member = ref->GetSource();
-        if (!member)
-            continue;
-
-        if (HasRestriction(member, kRestrictionSoloOnly))
-            return false;
-
-        bool memberHardcore = HasRestriction(member, kRestrictionHardcoreManualGroup);
-        if (memberHardcore != playerHardcore)
-            return false;
+        ChallengeConfig const& config = ChallengeConfig::Current();
+        return IsLfgCompatible(joiner, others, config.soloOnlyAllowLfg, config.hardcoreAllowLfg);
     }
 
-    return true;
+    return IsGroupCompatible(joiner, others);
 }
 
 bool ChallengeManager::HandleSummonAccept(Player* player, Unit* target, uint32 /*options*/)
@@ -1059,15 +1341,8 @@ bool ChallengeManager::HandleSummonAccept(Player* player, Unit* target, uint32 /
     if (!player)
         return true;
 
-    if (!HasRestriction(player, kRestrictionNoSummons))
-        return true;
-
-    // Summon teleports pass the summoner as target; other teleports often do not.
-    // TODO: Extend detection if additional summon/portal sources need coverage.
-    if (!target || target == player)
-        return true;
-
-    return false;
+    return DispatchRestrictions(RestrictionHook::Summon, GetRestrictionMask(player),
+        [player, target](ChallengeRestriction& restriction) { return restriction.OnSummonAccept(player, target); });
 }
 
 bool ChallengeManager::HandleDeath(Player* player)
@@ -1077,28 +1352,29 @@ bool ChallengeManager::HandleDeath(Player* player)
 
     uint32 guid = player->GetGUID().GetCounter();
     uint32 now = GameTime::GetGameTime().count();
+    ChallengePlayerState& state = GetOrLoadState(player);
 
-    auto consumeRecent = [now, guid](std::unordered_map<uint32, uint32>& marks)
+    auto consumeRecent = [now](uint32& mark)
     {
-        auto itr = marks.find(guid);
-        if (itr == marks.end())
+        if (mark == 0)
             return false;
 
-        bool recent = (now >= itr->second) && (now - itr->second <= 10);
-        marks.erase(itr);
+        bool recent = (now >= mark) && (now - mark <= 10);
+        mark = 0;
         return recent;
     };
 
-    bool wasPvp = consumeRecent(_pvpDeathMarks);
-    bool wasPve = consumeRecent(_pveDeathMarks);
+    bool wasPvp = consumeRecent(state.pvpDeathMark);
+    bool wasPve = consumeRecent(state.pveDeathMark);
 
-    if (!IsPermadeathEnabled())
+    ChallengeConfig const& config = ChallengeConfig::Current();
+    if (!config.permadeathEnabled)
         return false;
 
-    if (!HasRestriction(player, kRestrictionPermadeath))
+    if (!IsEnabled() || !HasRestriction(state, RestrictionId::Permadeath))
         return false;
 
-    if (_permadeathPendingKick.find(guid) != _permadeathPendingKick.end())
+    if (state.permadeathPending)
         return false;
 
     if (IsPermadead(player))
@@ -1110,22 +1386,22 @@ bool ChallengeManager::HandleDeath(Player* player)
     if (player->InArena())
     {
         reason = PermadeathReason::Arena;
-        counts = ShouldCountArenaDeath();
+        counts = config.permadeathCountArenaDeaths;
     }
     else if (player->InBattleground())
     {
         reason = PermadeathReason::Battleground;
-        counts = ShouldCountBattlegroundDeath();
+        counts = config.permadeathCountBattlegroundDeaths;
     }
     else if (IsDuelDeath(player))
     {
         reason = PermadeathReason::Duel;
-        counts = ShouldCountDuelDeath();
+        counts = config.permadeathCountDuelDeaths;
     }
     else if (wasPvp)
     {
         reason = PermadeathReason::PvP;
-        counts = ShouldCountPvPDeath();
+        counts = config.permadeathCountPvPDeaths;
     }
     else if (wasPve)
     {
@@ -1140,54 +1416,35 @@ bool ChallengeManager::HandleDeath(Player* player)
         return false;
 
     uint32 deathTime = GameTime::GetGameTime().count();
-    CharacterDatabase.Execute(
-        "INSERT INTO ip_permadeath (guid, is_dead, death_time, death_map, death_x, death_y, death_z, death_o, death_reason) "
-        "VALUES ({}, 1, {}, {}, {}, {}, {}, {}, {}) "
-        "ON DUPLICATE KEY UPDATE is_dead = 1, death_time = VALUES(death_time), death_map = VALUES(death_map), "
-        "death_x = VALUES(death_x), death_y = VALUES(death_y), death_z = VALUES(death_z), death_o = VALUES(death_o), "
-        "death_reason = VALUES(death_reason)",
-        guid, deathTime, player->GetMapId(), player->GetPositionX(), player->GetPositionY(),
-        player->GetPositionZ(), player->GetOrientation(), static_cast<uint8>(reason));
-
-    _permadeathCache.insert(guid);
-    _permadeathPendingKick.insert(guid);
-
-    uint8 tier = GetActiveTier(player);
-    uint32 flags = GetActiveFlags(player);
+    ChallengeWriteQueue::PermadeathRecord record;
+    record.deathTime = deathTime;
+    record.mapId = player->GetMapId();
+    record.x = player->GetPositionX();
+    record.y = player->GetPositionY();
+    record.z = player->GetPositionZ();
+    record.o = player->GetOrientation();
+    record.reason = static_cast<uint8>(reason);
+    ChallengeWriteQueue::Instance().WritePermadeath(guid, record);
+
+    ChallengePermadeathIndex::Instance().Insert(guid);
+    state.permadeathPending = true;
+
+    uint8 tier = state.tier;
+    uint32 flags = state.effectiveFlags;
     if (tier > 0)
     {
-        CharacterDatabase.Execute(
-            "INSERT INTO ip_challenge_runs (guid, tier, state, picked_flags, failed_flags, ended_at) "
-            "VALUES ({}, {}, {}, {}, {}, {}) "
-            "ON DUPLICATE KEY UPDATE state = {}, failed_flags = failed_flags | {}, ended_at = {}",
-            guid, tier, kRunStateFailed, flags, FLAG_PERMADEATH, deathTime,
-            kRunStateFailed, FLAG_PERMADEATH, deathTime);
+        ChallengeWriteQueue::Instance().QueueRunFailed(guid, tier, flags, FLAG_PERMADEATH, deathTime);
     }
 
     ClearActiveTierFlags(player);
 
-    if (ShouldBroadcastPermadeath())
+    if (config.permadeathBroadcast)
     {
         sWorldSessionMgr->SendServerMessage(SERVER_MSG_STRING, GetPermadeathBroadcastMessage(player));
     }
 
-    uint32 kickDelay = GetPermadeathKickDelaySeconds();
-    player->m_Events.AddEventAtOffset([guid]()
-        {
-            bool kicked = false;
-            if (Player* victim = ObjectAccessor::FindPlayerByLowGUID(guid))
-            {
-                if (WorldSession* session = victim->GetSession())
-                {
-                    time_t now = GameTime::GetGameTime().count();
-                    session->SetLogoutStartTime(now > 20 ? now - 20 : 0);
-                    kicked = true;
-                }
-            }
-
-            if (kicked)
-                ChallengeManager::Instance().ClearPermadeathPending(guid);
-        }, Seconds(kickDelay));
+    ChallengeTimerWheel::Instance().Schedule(guid, ChallengeTimer::PermadeathKick,
+        config.permadeathKickDelaySeconds * IN_MILLISECONDS);
 
     return true;
 }
@@ -1197,6 +1454,17 @@ bool ChallengeManager::HandleItemUse(Player* /*player*/, uint32 /*itemId*/)
     return true;
 }
 
+bool ChallengeManager::HandleMountCast(Player* player)
+{
+    if (!player)
+        return true;
+
+    if (HasRestriction(player, RestrictionId::NoMounts))
+        return false;
+
+    return true;
+}
+
 void ChallengeManager::UpsertChallengeRunActive(Player* player, uint8 tier, uint32 flags)
 {
     if (!player)
@@ -1204,10 +1472,71 @@ void ChallengeManager::UpsertChallengeRunActive(Player* player, uint8 tier, uint
 
     uint32 guid = player->GetGUID().GetCounter();
     uint32 now = GameTime::GetGameTime().count();
-    CharacterDatabase.Execute(
-        "INSERT INTO ip_challenge_runs (guid, tier, state, picked_flags, failed_flags, successful_flags, started_at, ended_at) "
-        "VALUES ({}, {}, {}, {}, 0, 0, {}, 0) "
-        "ON DUPLICATE KEY UPDATE state = {}, picked_flags = {}, failed_flags = 0, successful_flags = 0, started_at = {}, ended_at = 0",
-        guid, tier, kRunStateActive, flags, now,
-        kRunStateActive, flags, now);
+    ChallengeWriteQueue::Instance().QueueRunActive(guid, tier, flags, now);
+}
+
+bool ChallengeManager::HandleBotChat(Player* player, uint32 lang, std::string_view msg, Player* receiver, Group* group)
+{
+    if (!player || lang == LANG_ADDON)
+        return true;
+
+    ChallengeCommandMatcher const& matcher = ChallengeConfig::Current().botCommands;
+    bool combat = matcher.HasKind(BotCommandKind::Combat) && matcher.Classify(msg).kind == BotCommandKind::Combat;
+
+    BotRestrictions restrictions = combat ? GetBotRestrictions(player) : BotRestrictions();
+    Player* bot = restrictions.Any() ? FindRestrictedBot(player, receiver, group, restrictions) : nullptr;
+
+    ChallengeTraceRecorder& recorder = ChallengeTraceRecorder::Instance();
+    if (recorder.IsRecording())
+        recorder.Record(ChallengeTraceHook::BotChat, player->GetGUID().GetCounter(), combat, bot ? bot->GetGUID().GetCounter() : 0);
+
+    if (!bot)
+        return true;
+
+    SendMessage(player, ChallengeMessage::BotCommandBlocked);
+    return false;
+}
+
+bool ChallengeManager::HandleBotCommand(Player* player, std::string_view command)
+{
+    if (!player)
+        return true;
+
+    ChallengeCommandMatcher::Match match = ChallengeConfig::Current().botCommands.Classify(command);
+    if (match.kind == BotCommandKind::None || match.kind == BotCommandKind::Combat)
+        return true;
+
+    BotRestrictions restrictions = GetBotRestrictions(player);
+    if (!restrictions.Any())
+        return true;
+
+    if (match.kind == BotCommandKind::RandomBot || match.kind == BotCommandKind::AddClass)
+    {
+        SendMessage(player, restrictions.blockAll ? ChallengeMessage::BotsBlocked : ChallengeMessage::RndBotsBlocked);
+        return false;
+    }
+
+    if (restrictions.blockAll)
+    {
+        SendMessage(player, ChallengeMessage::BotsBlocked);
+        return false;
+    }
+
+    std::string_view target = FirstArgument(match.args);
+    if (target.empty() || target == "*" || target == "!")
+    {
+        SendMessage(player, ChallengeMessage::BotsRequireHardcore);
+        return false;
+    }
+
+    bool allowed = match.kind == BotCommandKind::AddAccount ? AreAccountBotsHardcore(target) :
+        ForEachCommaToken(target, [player](std::string_view name) { return IsHardcoreBotAllowed(player, name); });
+
+    if (!allowed)
+    {
+        SendMessage(player, ChallengeMessage::BotsRequireHardcore);
+        return false;
+    }
+
+    return true;
 }
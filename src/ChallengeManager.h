@@ -1,19 +1,56 @@
 #ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_MANAGER_H
 #define MOD_IP_CHALLENGESYSTEM_CHALLENGE_MANAGER_H
 
+#include "DatabaseEnvFwd.h"
 #include "Define.h"
 
+#include <array>
 #include <vector>
 #include <memory>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <string_view>
 
 class Player;
 class Group;
 class Unit;
 class Item;
+class Aura;
 class ChallengeRestriction;
+enum class RestrictionHook : uint8;
+struct ChallengePlayerState;
+struct ChallengeGroupMember;
+struct ChallengeGroupSummary;
+enum class ChallengeTimer : uint8;
+
+/**
+ * Atomic restriction identifiers.
+ *
+ * Order matches the descriptor table in ChallengeManager.cpp, which maps
+ * each id to its FLAG_* bit and test-aura config key.
+ */
+enum class RestrictionId : uint8
+{
+    HardcoreManualGroup = 0,
+    SoloOnly,
+    NoTrade,
+    NoMail,
+    NoAuction,
+    NoSummons,
+    Permadeath,
+    LowQualityOnly,
+    SelfCrafted,
+    Poverty,
+    NoGuildBank,
+    NoMounts,
+    NoBuffs,
+    NoTalents,
+    NoQuestXP,
+    OnlyQuestXP,
+    HalfXP,
+    QuarterXP,
+    NoBots,
+    Count
+};
 
 /**
  * ChallengeManager
@@ -23,13 +60,24 @@ class ChallengeRestriction;
  *  - Registered restrictions
  *  - Dispatching events to restrictions
  *
- * This class intentionally contains NO game logic yet.
+ * Threading: hooks for a player run on the map thread updating that player,
+ * which is the only writer of its ChallengePlayerState. Checks that involve
+ * another character (group members, mail receivers, offline guids) must go
+ * through ChallengeStateIndex rather than the other Player object.
+ * Deadlines (group grace, warnings, permadeath kick, NoBuffs sweep) live in
+ * ChallengeTimerWheel and are dispatched by UpdateTimers from the world
+ * update, after map threads have finished.
  */
 class ChallengeManager
 {
 public:
     static ChallengeManager& Instance();
     bool IsEnabled() const;
+    static char const* GetTestAuraConfigKey(RestrictionId restriction);
+    static uint32 GetRestrictionFlag(RestrictionId restriction);
+
+    // Number of RestrictionHook values (checked in ChallengeRestriction.h).
+    static constexpr size_t kRestrictionHookCount = 7;
 
     // Challenge flags (bitmask)
     static constexpr uint32 FLAG_HARDCORE   = 1;
@@ -58,26 +106,41 @@ public:
     void HandlePlayerLogin(Player* player);
     void HandlePlayerLogout(Player* player);
 
-    // Restriction registry
+    // Restriction registry. Populated while scripts load, read-only afterwards.
     void RegisterRestriction(std::shared_ptr<ChallengeRestriction> restriction);
 
     // Query
+    bool HasRestriction(Player* player, RestrictionId restriction);
     bool HasRestriction(Player* player, const std::string& restrictionId);
+    bool HasRestrictionByGuid(uint32 guid, RestrictionId restriction) const;
     uint8 GetActiveTier(Player* player);
     uint32 GetActiveFlags(Player* player);
     void SetActiveTierFlags(Player* player, uint8 tier, uint32 flags);
     void ClearActiveTierFlags(Player* player);
     bool IsPermadead(Player* player);
     bool IsPermadeathPending(Player* player) const;
-    void ClearPermadeathPending(uint32 guid);
+    void ClearPermadeathPending(Player* player);
     void RecordPvPDeath(Player* killed);
     void RecordPvEDeath(Player* killed);
     void UpsertChallengeRunActive(Player* player, uint8 tier, uint32 flags);
-    bool IsHardcoreGuid(uint32 guid);
-    uint32 EnforceEquipmentRestrictions(Player* player);
+    bool IsHardcoreGuid(uint32 guid) const;
+    bool IsAccountHardcore(uint32 accountId) const;
+    struct EquipmentEnforcement
+    {
+        uint32 stored = 0; // moved into the bags
+        uint32 mailed = 0; // bags full, sent back by mail
+        uint32 mails = 0;
+
+        uint32 Total() const { return stored + mailed; }
+    };
+
+    EquipmentEnforcement EnforceEquipmentRestrictions(Player* player);
     void EnforceNoTalents(Player* player);
     void EnforcePovertyCap(Player* player);
     void HandlePlayerUpdate(Player* player, uint32 diff);
+    void UpdateTimers(uint32 diff);
+    void HandleAuraApply(Player* player, Aura* aura);
+    void HandleAuraRemove(Player* player, Aura* aura);
     void HandleTalentPoints(Player* player, uint32& points);
     void HandleGiveXP(Player* player, uint32& amount, uint8 xpSource);
     void HandleQuestXP(Player* player, uint32& xpValue);
@@ -88,13 +151,23 @@ public:
     // Event dispatch (called from hooks)
     bool HandleTradeAttempt(Player* player, Player* target);
     bool HandleMailSend(Player* player);
+    bool HandleMailReceive(uint32 receiverGuid) const;
     bool HandleAuctionAction(Player* player);
     bool HandleGroupInvite(Player* player, Player* target);
     bool HandleGroupAccept(Player* player, Group* group);
+    void SeedGroupSummary(Group* group) const;
+    void HandleGroupMemberAdded(Group* group, uint32 memberGuid) const;
     bool HandleSummonAccept(Player* player, Unit* target, uint32 options);
     bool HandleItemUse(Player* player, uint32 itemId);
+    bool HandleMountCast(Player* player);
     bool HandleDeath(Player* player);
 
+    // Playerbot filter. Both send the refusal message themselves.
+    // A whispered or party/raid chat line, blocked when it is a combat command for a restricted bot.
+    bool HandleBotChat(Player* player, uint32 lang, std::string_view msg, Player* receiver, Group* group);
+    // A `.playerbots` recruitment command.
+    bool HandleBotCommand(Player* player, std::string_view command);
+
 private:
     ChallengeManager() = default;
 
@@ -104,18 +177,36 @@ private:
         uint32 flags = 0;
     };
 
-    ActiveState LoadActiveState(uint32 guid);
-    ActiveState& GetOrLoadActiveState(uint32 guid);
+    ActiveState LoadActiveState(uint32 guid) const;
+    static ActiveState MakeActiveState(uint8 tier, uint32 flags);
+    void ApplyPermadeathLockout(Player* player);
+    ChallengePlayerState* GetState(Player* player) const;
+    ChallengePlayerState& GetOrLoadState(Player* player);
+    static bool HasRestriction(ChallengePlayerState const& state, RestrictionId restriction);
+    void PublishState(Player* player, ChallengePlayerState const& state) const;
+    ChallengeGroupMember GetGroupMember(uint32 guid) const;
+    bool GetGroupSummary(Group* group, uint32 excludeGuid, ChallengeGroupSummary& out) const;
+    void RefreshGroupValidity(Player* player, ChallengePlayerState& state);
+    void CancelGroupGrace(Player* player, ChallengePlayerState& state);
+    void HandleTimer(Player* player, ChallengeTimer timer);
+    void RemoveForbiddenBuffs(Player* player);
+    void RefreshTestAuraFlags(Player* player, ChallengePlayerState& state) const;
+
+    struct RestrictionHandler
+    {
+        uint32 flag = 0;
+        ChallengeRestriction* restriction = nullptr;
+    };
+
+    uint32 GetRestrictionMask(Player* player);
+    template<typename Fn>
+    bool DispatchRestrictions(RestrictionHook hook, uint32 restrictionMask, Fn&& fn) const;
 
     std::vector<std::shared_ptr<ChallengeRestriction>> _restrictions;
-    std::unordered_map<uint32, ActiveState> _activeStates;
-    std::unordered_set<uint32> _permadeathPendingKick;
-    std::unordered_set<uint32> _permadeathCache;
-    std::unordered_map<uint32, uint32> _pvpDeathMarks;
-    std::unordered_map<uint32, uint32> _pveDeathMarks;
-    std::unordered_map<uint32, uint32> _noBuffsUpdateAccumulator;
-    std::unordered_map<uint32, uint32> _groupViolationGraceDeadline;
-    std::unordered_map<uint32, uint32> _groupViolationLastWarningAt;
+
+    // Per RestrictionHook: the restrictions implementing it, and the union of their flags.
+    std::array<std::vector<RestrictionHandler>, kRestrictionHookCount> _hookHandlers;
+    std::array<uint32, kRestrictionHookCount> _hookFlags = {};
 };
 
 #endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_MANAGER_H
@@ -0,0 +1,61 @@
+#include "ChallengePermadeathIndex.h"
+#include "ChallengeDatabase.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <algorithm>
+#include <mutex>
+
+ChallengePermadeathIndex& ChallengePermadeathIndex::Instance()
+{
+    static ChallengePermadeathIndex instance;
+    return instance;
+}
+
+void ChallengePermadeathIndex::LoadFromDB()
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::vector<uint32> guids;
+    ChallengeDatabasePreparedStatement* stmt = ChallengeDatabase::Instance().GetPreparedStatement(CHALLENGE_SEL_PERMADEAD_GUIDS);
+    if (PreparedQueryResult result = ChallengeDatabase::Instance().Query(stmt))
+    {
+        guids.reserve(result->GetRowCount());
+        do
+        {
+            guids.push_back(result->Fetch()[0].Get<uint32>());
+        } while (result->NextRow());
+    }
+
+    guids.shrink_to_fit();
+
+    {
+        std::unique_lock<std::shared_mutex> guard(_lock);
+        _guids.swap(guids);
+    }
+
+    LOG_INFO("server.loading", ">> Loaded {} permadead characters in {} ms", Size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+bool ChallengePermadeathIndex::Contains(uint32 guid) const
+{
+    std::shared_lock<std::shared_mutex> guard(_lock);
+    return std::binary_search(_guids.begin(), _guids.end(), guid);
+}
+
+void ChallengePermadeathIndex::Insert(uint32 guid)
+{
+    std::unique_lock<std::shared_mutex> guard(_lock);
+    auto itr = std::lower_bound(_guids.begin(), _guids.end(), guid);
+    if (itr != _guids.end() && *itr == guid)
+        return;
+
+    _guids.insert(itr, guid);
+}
+
+size_t ChallengePermadeathIndex::Size() const
+{
+    std::shared_lock<std::shared_mutex> guard(_lock);
+    return _guids.size();
+}
@@ -0,0 +1,33 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_PERMADEATH_INDEX_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_PERMADEATH_INDEX_H
+
+#include "Define.h"
+
+#include <shared_mutex>
+#include <vector>
+
+/**
+ * ChallengePermadeathIndex
+ *
+ * Sorted list of every permadead character guid (4 bytes per entry).
+ * Loaded in bulk from ip_permadeath at world startup and kept in sync by
+ * HandleDeath, so permadeath checks never query the database.
+ */
+class ChallengePermadeathIndex
+{
+public:
+    static ChallengePermadeathIndex& Instance();
+
+    void LoadFromDB();
+    bool Contains(uint32 guid) const;
+    void Insert(uint32 guid);
+    size_t Size() const;
+
+private:
+    ChallengePermadeathIndex() = default;
+
+    mutable std::shared_mutex _lock;
+    std::vector<uint32> _guids;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_PERMADEATH_INDEX_H
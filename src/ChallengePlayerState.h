@@ -0,0 +1,86 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_PLAYER_STATE_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_PLAYER_STATE_H
+
+#include "DataMap.h"
+#include "Define.h"
+
+#include <vector>
+
+struct ChallengeConfig;
+
+/**
+ * ChallengePlayerState
+ *
+ * Everything the module tracks for an online character, stored in the
+ * Player's CustomData slot so a hook reaches all of it with one lookup.
+ * The record is freed with the Player or explicitly at logout.
+ */
+struct ChallengePlayerState : public DataMap::Base
+{
+    static constexpr char const* kDataKey = "ip_challengesystem";
+
+    uint8 tier = 0;
+    bool permadeathPending = false;
+
+    // Persisted flags, and the flags actually in force (0 while no tier is active).
+    uint32 flags = 0;
+    uint32 effectiveFlags = 0;
+
+    // Restriction bits granted by configured DEV test auras. The owner's update
+    // recomputes them when one of those auras comes or goes, or the config is reloaded.
+    uint32 testAuraFlags = 0;
+    bool testAurasDirty = false;
+    uint32 testAuraGeneration = ~0u; // ChallengeConfig::generation they were computed for
+
+    // effectiveFlags | testAuraFlags: the one word every restriction check reads.
+    uint32 restrictionMask = 0;
+
+    // Game time (seconds) of the last PvP / PvE kill, consumed by HandleDeath.
+    uint32 pvpDeathMark = 0;
+    uint32 pveDeathMark = 0;
+
+    // NO_MOUNTS was in force at the last update; entering it dismounts once.
+    bool noMountsActive = false;
+
+    // A mount aura slipped past the cast check; dismount on the owner's next update.
+    bool dismountPending = false;
+
+    // NO_BUFFS was in force at the last update; the optional sweep timer runs while set.
+    bool noBuffsActive = false;
+
+    // Forbidden buffs caught by the aura-apply hook, stripped on the owner's next update.
+    std::vector<uint32> pendingBuffRemovals;
+
+    // Group validity, recomputed only when the group or its ChallengeGroupIndex version changes.
+    uint32 groupGuid = 0;
+    uint32 groupVersion = 0;
+    bool groupLfg = false;
+    uint32 groupInvalidSince = 0;
+
+    void SetTierFlags(uint8 newTier, uint32 newFlags)
+    {
+        tier = newTier;
+        flags = newFlags;
+        effectiveFlags = newTier ? newFlags : 0;
+        restrictionMask = effectiveFlags | testAuraFlags;
+    }
+
+    void SetTestAuraFlags(uint32 auraFlags)
+    {
+        testAuraFlags = auraFlags;
+        restrictionMask = effectiveFlags | testAuraFlags;
+    }
+
+    // What other threads see for this character through ChallengeStateIndex.
+    uint32 GetPublishedFlags() const { return restrictionMask; }
+
+    void ClearGroupGrace()
+    {
+        groupGuid = 0;
+        groupVersion = 0;
+        groupLfg = false;
+        groupInvalidSince = 0;
+    }
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_PLAYER_STATE_H
@@ -2,17 +2,47 @@
 #define MOD_IP_CHALLENGESYSTEM_CHALLENGE_RESTRICTION_H
 
 #include "Define.h"
+#include "ChallengeManager.h"
 
-#include <string>
-#include <cstdint>
-
+class Item;
 class Player;
+class Unit;
+
+/**
+ * Hooks a restriction can implement. ChallengeManager keeps one dispatch
+ * list per hook, so an event only reaches the restrictions that declared it.
+ */
+enum class RestrictionHook : uint8
+{
+    Trade = 0,   // called once for each side of the trade
+    MailSend,
+    MailReceive, // receiver may be offline; only its guid is known
+    Auction,
+    Summon,
+    EquipItem,
+    GuildBank,
+    Count
+};
+
+static_assert(static_cast<size_t>(RestrictionHook::Count) == ChallengeManager::kRestrictionHookCount,
+    "ChallengeManager::kRestrictionHookCount must match RestrictionHook");
+
+constexpr uint32 RestrictionHookMask(RestrictionHook hook)
+{
+    return 1u << static_cast<uint8>(hook);
+}
 
 /**
  * Atomic restriction interface.
  *
- * Each restriction represents ONE enforceable rule.
- * Restrictions are composed into challenge presets.
+ * Each restriction represents ONE enforceable rule, bound to one
+ * RestrictionId. Restrictions are composed into challenge presets.
+ *
+ * A restriction is only called for characters that have its flag in force,
+ * and only for the hooks listed in GetHooks(). ChallengeManager dispatches
+ * through ChallengeRestriction pointers, so those calls stay virtual; the
+ * per-hook flag mask is what keeps them off the hot path. Implementations
+ * are final only to mark them as leaves.
  *
  * Enforcement philosophy:
  *  - Prefer BLOCK
@@ -24,8 +54,10 @@ class ChallengeRestriction
 public:
     virtual ~ChallengeRestriction() = default;
 
-    // Unique string identifier (e.g. "NO_TRADE", "PERMADEATH")
-    virtual std::string GetId() const = 0;
+    virtual RestrictionId GetRestrictionId() const = 0;
+
+    // RestrictionHookMask bits of the hooks this restriction implements
+    virtual uint32 GetHooks() const = 0;
 
     // Called when a tier run starts
     virtual void OnTierStart(Player* /*player*/) {}
@@ -33,17 +65,16 @@ public:
     // Called when a tier run ends (completed or failed)
     virtual void OnTierEnd(Player* /*player*/) {}
 
-    // --- Optional hooks ---
-    // Restrictions override only what they need.
+    // --- Hooks ---
+    // Return false to block. Restrictions override only what they declare.
 
-    virtual bool OnTradeAttempt(Player* /*player*/) { return true; }
+    virtual bool OnTradeAttempt(Player* /*player*/, Player* /*other*/) { return true; }
     virtual bool OnMailSend(Player* /*player*/) { return true; }
+    virtual bool OnMailReceive(uint32 /*receiverGuid*/) { return true; }
     virtual bool OnAuctionAction(Player* /*player*/) { return true; }
-    virtual bool OnGroupInvite(Player* /*player*/, Player* /*target*/) { return true; }
-    virtual bool OnGroupAccept(Player* /*player*/) { return true; }
-    virtual bool OnSummonAccept(Player* /*player*/) { return true; }
-    virtual bool OnItemUse(Player* /*player*/, uint32 /*itemId*/) { return true; }
-    virtual void OnDeath(Player* /*player*/) {}
+    virtual bool OnSummonAccept(Player* /*player*/, Unit* /*summoner*/) { return true; }
+    virtual bool OnEquipItem(Player* /*player*/, Item* /*item*/) { return true; }
+    virtual bool OnGuildBankAccess(Player* /*player*/) { return true; }
 };
 
 #endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_RESTRICTION_H
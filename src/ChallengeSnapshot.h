@@ -0,0 +1,71 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_SNAPSHOT_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_SNAPSHOT_H
+
+#include "Define.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * ChallengeSnapshot
+ *
+ * Publishes immutable snapshots (config, spell table) through one atomic
+ * pointer. Readers on map threads may still hold a reference to the
+ * previous snapshot when a new one is published, so it is retired rather
+ * than freed. Reclaim runs once per world update and frees what was retired
+ * at least kGraceUpdates updates earlier. By then every map update that
+ * could have read it has finished.
+ */
+template<typename T>
+class ChallengeSnapshot
+{
+public:
+    static constexpr uint32 kGraceUpdates = 2;
+
+    // Published snapshot, or nullptr before the first Publish.
+    T const* Get() const { return _current.load(std::memory_order_acquire); }
+
+    void Publish(std::unique_ptr<T const> snapshot)
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_owned)
+            _retired.push_back({ std::move(_owned), _updates });
+
+        _owned = std::move(snapshot);
+        _current.store(_owned.get(), std::memory_order_release);
+    }
+
+    void Reclaim()
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        ++_updates;
+        _retired.erase(std::remove_if(_retired.begin(), _retired.end(), [this](Retired const& retired)
+        {
+            return _updates - retired.retiredAt >= kGraceUpdates;
+        }), _retired.end());
+    }
+
+    size_t GetRetiredCount() const
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        return _retired.size();
+    }
+
+private:
+    struct Retired
+    {
+        std::unique_ptr<T const> snapshot;
+        uint64 retiredAt = 0;
+    };
+
+    std::atomic<T const*> _current{ nullptr };
+    mutable std::mutex _lock;
+    std::unique_ptr<T const> _owned;
+    std::vector<Retired> _retired;
+    uint64 _updates = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_SNAPSHOT_H
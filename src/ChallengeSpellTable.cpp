@@ -0,0 +1,70 @@
+#include "ChallengeSpellTable.h"
+#include "ChallengeConfig.h"
+#include "ChallengeSnapshot.h"
+#include "Log.h"
+#include "SpellInfo.h"
+#include "SpellMgr.h"
+#include "Timer.h"
+
+#include <memory>
+
+namespace
+{
+ChallengeSnapshot<ChallengeSpellTable> sSnapshot;
+}
+
+ChallengeSpellTable const& ChallengeSpellTable::Current()
+{
+    ChallengeSpellTable const* table = sSnapshot.Get();
+    if (table)
+        return *table;
+
+    static ChallengeSpellTable const empty;
+    return empty;
+}
+
+void ChallengeSpellTable::Build(ChallengeConfig const& config)
+{
+    uint32 oldMSTime = getMSTime();
+
+    auto table = std::make_unique<ChallengeSpellTable>();
+    uint32 storeSize = sSpellMgr->GetSpellInfoStoreSize();
+    for (auto& bits : table->_bits)
+        bits.assign((storeSize + 63) / 64, 0);
+
+    for (uint32 spellId = 0; spellId < storeSize; ++spellId)
+    {
+        SpellInfo const* spellInfo = sSpellMgr->GetSpellInfo(spellId);
+        if (!spellInfo)
+            continue;
+
+        ++table->_spellCount;
+
+        if (spellInfo->HasAura(SPELL_AURA_MOUNTED))
+            table->Set(spellId, ChallengeSpellClass::Mount);
+
+        // Config is folded in here, so a NO_BUFFS check is one bit test.
+        bool allowListed = config.noBuffsAllowSpells.find(spellId) != config.noBuffsAllowSpells.end();
+        bool allowedPassive = config.noBuffsAllowPassive && spellInfo->IsPassive();
+        if (spellInfo->IsPositive() && !allowListed && !allowedPassive)
+            table->Set(spellId, ChallengeSpellClass::ForbiddenBuff);
+    }
+
+    LOG_INFO("server.loading", ">> Classified {} spells for Challenge restrictions ({} KB) in {} ms",
+        table->GetSpellCount(), table->GetMemoryUsage() / 1024, GetMSTimeDiffToNow(oldMSTime));
+
+    sSnapshot.Publish(std::move(table));
+}
+
+void ChallengeSpellTable::ReclaimRetired()
+{
+    sSnapshot.Reclaim();
+}
+
+size_t ChallengeSpellTable::GetMemoryUsage() const
+{
+    size_t bytes = 0;
+    for (auto const& bits : _bits)
+        bytes += bits.capacity() * sizeof(uint64);
+    return bytes;
+}
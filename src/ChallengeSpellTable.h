@@ -0,0 +1,66 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_SPELL_TABLE_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_SPELL_TABLE_H
+
+#include "Define.h"
+
+#include <array>
+#include <vector>
+
+struct ChallengeConfig;
+
+/**
+ * Per-spell facts the restrictions ask about, one bit array each.
+ */
+enum class ChallengeSpellClass : uint8
+{
+    Mount = 0,     // applies SPELL_AURA_MOUNTED
+    ForbiddenBuff, // removed under NO_BUFFS: positive, not allow-listed, not an allowed passive
+    Count
+};
+
+/**
+ * ChallengeSpellTable
+ *
+ * Dense bit arrays indexed by spell id, built once from sSpellMgr at world
+ * startup and again on `.reload config`, so every aura decision is a single
+ * bit test instead of SpellInfo calls and a hash lookup.
+ *
+ * Tables are immutable once published and, like ChallengeConfig snapshots,
+ * a superseded table is only freed once no map thread can still be reading
+ * it (ChallengeSnapshot). Before the first build every lookup is false.
+ */
+class ChallengeSpellTable
+{
+public:
+    // Currently published table. Never null.
+    static ChallengeSpellTable const& Current();
+
+    // Classify every spell in sSpellMgr against config and publish the result.
+    static void Build(ChallengeConfig const& config);
+
+    // Free superseded tables no hook can still be reading. World update only.
+    static void ReclaimRetired();
+
+    bool Has(uint32 spellId, ChallengeSpellClass spellClass) const
+    {
+        std::vector<uint64> const& bits = _bits[static_cast<size_t>(spellClass)];
+        size_t word = spellId >> 6;
+        return word < bits.size() && (bits[word] >> (spellId & 63)) & 1;
+    }
+
+    bool IsForbiddenBuff(uint32 spellId) const { return Has(spellId, ChallengeSpellClass::ForbiddenBuff); }
+
+    uint32 GetSpellCount() const { return _spellCount; }
+    size_t GetMemoryUsage() const;
+
+private:
+    void Set(uint32 spellId, ChallengeSpellClass spellClass)
+    {
+        _bits[static_cast<size_t>(spellClass)][spellId >> 6] |= uint64(1) << (spellId & 63);
+    }
+
+    uint32 _spellCount = 0;
+    std::array<std::vector<uint64>, static_cast<size_t>(ChallengeSpellClass::Count)> _bits;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_SPELL_TABLE_H
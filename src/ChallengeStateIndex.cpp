@@ -0,0 +1,90 @@
+#include "ChallengeStateIndex.h"
+#include "ChallengeConfig.h"
+#include "ChallengeDatabase.h"
+#include "DatabaseEnv.h"
+#include "Log.h"
+#include "Timer.h"
+
+#include <mutex>
+
+ChallengeStateIndex& ChallengeStateIndex::Instance()
+{
+    static ChallengeStateIndex instance;
+    return instance;
+}
+
+void ChallengeStateIndex::LoadFromDB()
+{
+    uint32 oldMSTime = getMSTime();
+
+    std::array<std::unordered_map<uint32, Entry>, kShardCount> entries;
+    ChallengeDatabasePreparedStatement* stmt = ChallengeDatabase::Instance().GetPreparedStatement(CHALLENGE_SEL_ALL_STATES);
+    if (PreparedQueryResult result = ChallengeDatabase::Instance().Query(stmt))
+    {
+        do
+        {
+            Field* fields = result->Fetch();
+            uint32 guid = fields[0].Get<uint32>();
+            uint8 tier = fields[1].Get<uint8>();
+            uint32 flags = fields[2].Get<uint32>();
+            if (tier == 0 || tier > ChallengeConfig::kTierMax)
+                continue;
+
+            entries[guid % kShardCount][guid] = { tier, flags };
+        } while (result->NextRow());
+    }
+
+    for (size_t i = 0; i < kShardCount; ++i)
+    {
+        std::unique_lock<std::shared_mutex> guard(_shards[i].lock);
+        _shards[i].entries.swap(entries[i]);
+    }
+
+    LOG_INFO("server.loading", ">> Loaded challenge state for {} characters in {} ms", Size(), GetMSTimeDiffToNow(oldMSTime));
+}
+
+ChallengeStateIndex::Entry ChallengeStateIndex::Publish(uint32 guid, uint8 tier, uint32 flags)
+{
+    Shard& shard = GetShard(guid);
+    std::unique_lock<std::shared_mutex> guard(shard.lock);
+
+    Entry previous;
+    auto itr = shard.entries.find(guid);
+    if (itr != shard.entries.end())
+        previous = itr->second;
+
+    if (tier == 0 && flags == 0)
+    {
+        if (itr != shard.entries.end())
+            shard.entries.erase(itr);
+    }
+    else if (itr != shard.entries.end())
+        itr->second = { tier, flags };
+    else
+        shard.entries.emplace(guid, Entry{ tier, flags });
+
+    return previous;
+}
+
+bool ChallengeStateIndex::Find(uint32 guid, Entry& out) const
+{
+    Shard const& shard = GetShard(guid);
+    std::shared_lock<std::shared_mutex> guard(shard.lock);
+    auto itr = shard.entries.find(guid);
+    if (itr == shard.entries.end())
+        return false;
+
+    out = itr->second;
+    return true;
+}
+
+size_t ChallengeStateIndex::Size() const
+{
+    size_t size = 0;
+    for (Shard const& shard : _shards)
+    {
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        size += shard.entries.size();
+    }
+    return size;
+}
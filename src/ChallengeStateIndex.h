@@ -0,0 +1,71 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_STATE_INDEX_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_STATE_INDEX_H
+
+#include "Define.h"
+
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+
+/**
+ * ChallengeStateIndex
+ *
+ * Server-wide guid -> (tier, flags) table covering every character, online
+ * or not. It is loaded in bulk from ip_challenge_state at world startup and
+ * is the only place challenge state is read from afterwards: login, group
+ * members, mail receivers and bot names all resolve here without the DB.
+ *
+ * A player's own ChallengePlayerState is only touched by the map thread
+ * updating that player; whenever it changes, the owner publishes the
+ * result here. Characters without an active tier have no entry.
+ *
+ * Entries are spread over independently locked shards so concurrent map
+ * threads rarely contend, and readers only take a shared lock.
+ */
+class ChallengeStateIndex
+{
+public:
+    struct Entry
+    {
+        uint8 tier = 0;
+        uint32 flags = 0;
+    };
+
+    static ChallengeStateIndex& Instance();
+
+    void LoadFromDB();
+    // Returns the entry it replaced (tier 0 when there was none).
+    Entry Publish(uint32 guid, uint8 tier, uint32 flags);
+    bool Find(uint32 guid, Entry& out) const;
+    size_t Size() const;
+
+    // Calls fn(guid, entry) for every entry, one shard at a time.
+    template<typename Fn>
+    void ForEach(Fn&& fn) const
+    {
+        for (Shard const& shard : _shards)
+        {
+            std::shared_lock<std::shared_mutex> guard(shard.lock);
+            for (auto const& [guid, entry] : shard.entries)
+                fn(guid, entry);
+        }
+    }
+
+private:
+    ChallengeStateIndex() = default;
+
+    static constexpr size_t kShardCount = 64;
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex lock;
+        std::unordered_map<uint32, Entry> entries;
+    };
+
+    Shard& GetShard(uint32 guid) { return _shards[guid % kShardCount]; }
+    Shard const& GetShard(uint32 guid) const { return _shards[guid % kShardCount]; }
+
+    std::array<Shard, kShardCount> _shards;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_STATE_INDEX_H
@@ -0,0 +1,196 @@
+#include "ChallengeTimerWheel.h"
+
+#include <algorithm>
+
+ChallengeTimerWheel& ChallengeTimerWheel::Instance()
+{
+    static ChallengeTimerWheel instance;
+    return instance;
+}
+
+ChallengeTimerWheel::ChallengeTimerWheel()
+{
+    for (auto& level : _slots)
+        level.fill(kNone);
+}
+
+void ChallengeTimerWheel::Schedule(uint32 guid, ChallengeTimer timer, uint32 delayMs)
+{
+    constexpr uint64 kMaxTicks = (uint64(1) << (kSlotBits * kLevelCount)) - 1;
+    uint64 ticks = std::clamp<uint64>((uint64(delayMs) + kResolutionMs - 1) / kResolutionMs, 1, kMaxTicks);
+
+    std::lock_guard<std::mutex> guard(_lock);
+
+    auto [itr, inserted] = _owners.try_emplace(guid);
+    OwnerTimers& owned = itr->second;
+    if (inserted)
+        owned.fill(kNone);
+
+    CancelLocked(owned, timer);
+
+    uint32 index;
+    if (_freeList != kNone)
+    {
+        index = _freeList;
+        _freeList = _nodes[index].next;
+    }
+    else
+    {
+        index = static_cast<uint32>(_nodes.size());
+        _nodes.emplace_back();
+    }
+
+    Node& node = _nodes[index];
+    node.expiresAt = _now + ticks;
+    node.guid = guid;
+    node.timer = timer;
+    Link(index);
+
+    owned[static_cast<size_t>(timer)] = index;
+}
+
+void ChallengeTimerWheel::Cancel(uint32 guid, ChallengeTimer timer)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _owners.find(guid);
+    if (itr == _owners.end())
+        return;
+
+    CancelLocked(itr->second, timer);
+    if (std::all_of(itr->second.begin(), itr->second.end(), [](uint32 index) { return index == kNone; }))
+        _owners.erase(itr);
+}
+
+void ChallengeTimerWheel::CancelAll(uint32 guid)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    auto itr = _owners.find(guid);
+    if (itr == _owners.end())
+        return;
+
+    for (uint32 index : itr->second)
+    {
+        if (index == kNone)
+            continue;
+
+        Unlink(index);
+        Release(index);
+    }
+
+    _owners.erase(itr);
+}
+
+void ChallengeTimerWheel::Update(uint32 diff, std::vector<Expired>& expired)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+
+    _remainderMs += diff;
+    while (_remainderMs >= kResolutionMs)
+    {
+        _remainderMs -= kResolutionMs;
+        ++_now;
+
+        uint32 slot = static_cast<uint32>(_now & (kSlotCount - 1));
+        if (slot == 0)
+        {
+            // Entering a new lap: pull the next coarser slot down, level by level.
+            for (uint32 level = 1; level < kLevelCount; ++level)
+            {
+                Cascade(level);
+                if (((_now >> (kSlotBits * level)) & (kSlotCount - 1)) != 0)
+                    break;
+            }
+        }
+
+        uint32 index = _slots[0][slot];
+        _slots[0][slot] = kNone;
+        while (index != kNone)
+        {
+            Node& node = _nodes[index];
+            uint32 next = node.next;
+
+            expired.push_back({ node.guid, node.timer });
+
+            auto itr = _owners.find(node.guid);
+            if (itr != _owners.end())
+            {
+                itr->second[static_cast<size_t>(node.timer)] = kNone;
+                if (std::all_of(itr->second.begin(), itr->second.end(), [](uint32 owned) { return owned == kNone; }))
+                    _owners.erase(itr);
+            }
+
+            Release(index);
+            index = next;
+        }
+    }
+}
+
+void ChallengeTimerWheel::Link(uint32 index)
+{
+    Node& node = _nodes[index];
+    uint64 delta = node.expiresAt > _now ? node.expiresAt - _now : 0;
+
+    uint32 level = 0;
+    while (level + 1 < kLevelCount && delta >= (uint64(1) << (kSlotBits * (level + 1))))
+        ++level;
+
+    uint64 expiresAt = std::max(node.expiresAt, _now);
+    uint32& head = _slots[level][(expiresAt >> (kSlotBits * level)) & (kSlotCount - 1)];
+
+    node.head = &head;
+    node.prev = kNone;
+    node.next = head;
+    if (head != kNone)
+        _nodes[head].prev = index;
+    head = index;
+}
+
+void ChallengeTimerWheel::Unlink(uint32 index)
+{
+    Node& node = _nodes[index];
+    if (node.prev != kNone)
+        _nodes[node.prev].next = node.next;
+    else
+        *node.head = node.next;
+
+    if (node.next != kNone)
+        _nodes[node.next].prev = node.prev;
+
+    node.head = nullptr;
+    node.prev = kNone;
+    node.next = kNone;
+}
+
+void ChallengeTimerWheel::Release(uint32 index)
+{
+    Node& node = _nodes[index];
+    node.head = nullptr;
+    node.prev = kNone;
+    node.next = _freeList;
+    _freeList = index;
+}
+
+void ChallengeTimerWheel::CancelLocked(OwnerTimers& owned, ChallengeTimer timer)
+{
+    uint32& index = owned[static_cast<size_t>(timer)];
+    if (index == kNone)
+        return;
+
+    Unlink(index);
+    Release(index);
+    index = kNone;
+}
+
+void ChallengeTimerWheel::Cascade(uint32 level)
+{
+    uint32& head = _slots[level][(_now >> (kSlotBits * level)) & (kSlotCount - 1)];
+    uint32 index = head;
+    head = kNone;
+
+    while (index != kNone)
+    {
+        uint32 next = _nodes[index].next;
+        Link(index);
+        index = next;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_TIMER_WHEEL_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_TIMER_WHEEL_H
+
+#include "Define.h"
+
+#include <array>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Per-character deadlines owned by ChallengeTimerWheel. A character has at
+ * most one pending timer of each kind.
+ */
+enum class ChallengeTimer : uint8
+{
+    GroupGrace = 0, // invalid group: remove the player
+    GroupWarning,   // invalid group: periodic "leave your group" reminder
+    PermadeathKick, // permadeath: log the character out
+    NoBuffsScan,    // NO_BUFFS: safety sweep of applied auras
+    Count
+};
+
+/**
+ * ChallengeTimerWheel
+ *
+ * Hierarchical timing wheel (4 levels x 64 slots, 100 ms resolution) for
+ * every deadline the module tracks. Schedule and Cancel are O(1): timers are
+ * pooled nodes linked into their slot, and each character keeps the node
+ * index of its timers per kind so a logout drops them all in one call.
+ * Characters with nothing scheduled are never visited. A delay is rounded
+ * up to whole ticks and fires on the Update that completes that many ticks;
+ * delays beyond the top level's span fire at the end of it (~19 days).
+ *
+ * Timers may be scheduled from any map thread. Update runs from the world
+ * thread's WorldScript::OnUpdate, after map updates have finished, and hands
+ * expired timers back to the caller to dispatch.
+ */
+class ChallengeTimerWheel
+{
+public:
+    struct Expired
+    {
+        uint32 guid;
+        ChallengeTimer timer;
+    };
+
+    static constexpr uint32 kResolutionMs = 100;
+
+    static ChallengeTimerWheel& Instance();
+
+    void Schedule(uint32 guid, ChallengeTimer timer, uint32 delayMs);
+    void Cancel(uint32 guid, ChallengeTimer timer);
+    void CancelAll(uint32 guid);
+
+    void Update(uint32 diff, std::vector<Expired>& expired);
+
+private:
+    ChallengeTimerWheel();
+
+    static constexpr uint32 kSlotBits = 6;
+    static constexpr uint32 kSlotCount = 1u << kSlotBits;
+    static constexpr uint32 kLevelCount = 4;
+    static constexpr uint32 kNone = ~0u;
+
+    struct Node
+    {
+        uint64 expiresAt = 0;
+        uint32 guid = 0;
+        ChallengeTimer timer = ChallengeTimer::Count;
+        uint32 prev = kNone;
+        uint32 next = kNone;
+        uint32* head = nullptr; // slot list this node is linked into
+    };
+
+    using OwnerTimers = std::array<uint32, static_cast<size_t>(ChallengeTimer::Count)>;
+
+    void Link(uint32 index);
+    void Unlink(uint32 index);
+    void Release(uint32 index);
+    void CancelLocked(OwnerTimers& owned, ChallengeTimer timer);
+    void Cascade(uint32 level);
+
+    std::mutex _lock;
+    std::vector<Node> _nodes;
+    uint32 _freeList = kNone;
+    std::array<std::array<uint32, kSlotCount>, kLevelCount> _slots;
+    std::unordered_map<uint32, OwnerTimers> _owners;
+    uint64 _now = 0; // last tick processed
+    uint32 _remainderMs = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_TIMER_WHEEL_H
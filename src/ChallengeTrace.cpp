@@ -0,0 +1,208 @@
+#include "ChallengeTrace.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengeStateIndex.h"
+#include "Log.h"
+
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <system_error>
+
+namespace
+{
+constexpr char kTraceMagic[4] = { 'I', 'P', 'C', 'T' };
+constexpr uint32 kTraceVersion = 2;
+constexpr size_t kHeaderSize = 8;
+constexpr size_t kRecordSize = 17;
+constexpr size_t kFlushThreshold = 64 * 1024;
+
+constexpr char const* kHookNames[] =
+{
+    "login", "logout", "update", "group_invite", "group_accept", "trade", "mail_send", "mail_receive",
+    "auction", "equip_item", "money_changed", "talent_points", "give_xp", "quest_xp", "summon", "death",
+    "guild_bank", "mount_cast", "aura_apply", "aura_remove", "bot_chat", "state_changed", "group_create",
+    "group_add_member", "group_remove_member", "group_change_leader", "group_disband"
+};
+
+static_assert(std::size(kHookNames) == static_cast<size_t>(ChallengeTraceHook::Count),
+    "kHookNames must cover every ChallengeTraceHook");
+
+void PutUInt32(uint8* out, uint32 value)
+{
+    out[0] = static_cast<uint8>(value);
+    out[1] = static_cast<uint8>(value >> 8);
+    out[2] = static_cast<uint8>(value >> 16);
+    out[3] = static_cast<uint8>(value >> 24);
+}
+
+uint32 GetUInt32(uint8 const* in)
+{
+    return uint32(in[0]) | (uint32(in[1]) << 8) | (uint32(in[2]) << 16) | (uint32(in[3]) << 24);
+}
+}
+
+ChallengeTraceRecorder& ChallengeTraceRecorder::Instance()
+{
+    static ChallengeTraceRecorder instance;
+    return instance;
+}
+
+bool ChallengeTraceRecorder::Start(std::string const& path)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (_file)
+        return false;
+
+    std::error_code error;
+    std::filesystem::path parent = std::filesystem::path(path).parent_path();
+    if (!parent.empty())
+        std::filesystem::create_directories(parent, error);
+
+    _file = std::fopen(path.c_str(), "wb");
+    if (!_file)
+    {
+        LOG_ERROR("module", "ChallengeSystem: cannot open trace file '{}'.", path);
+        return false;
+    }
+
+    uint8 header[kHeaderSize];
+    std::memcpy(header, kTraceMagic, sizeof(kTraceMagic));
+    PutUInt32(header + 4, kTraceVersion);
+    std::fwrite(header, 1, sizeof(header), _file);
+
+    _path = path;
+    _buffer.clear();
+    _buffer.reserve(kFlushThreshold + kRecordSize);
+    _startedAt = std::chrono::steady_clock::now();
+    _recordCount.store(0, std::memory_order_relaxed);
+    _recording.store(true, std::memory_order_relaxed);
+
+    // Changes published while seeding wait for the lock and land after the seed.
+    ChallengeStateIndex::Instance().ForEach([this](uint32 guid, ChallengeStateIndex::Entry const& entry)
+    {
+        AppendLocked(ChallengeTraceHook::StateChanged, 0, guid, entry.tier, entry.flags);
+    });
+    ChallengeGroupIndex::Instance().ForEachMember([this](uint32 groupGuid, uint32 memberGuid, ChallengeGroupMember const& /*member*/)
+    {
+        AppendLocked(ChallengeTraceHook::GroupAddMember, 0, memberGuid, groupGuid, 0);
+    });
+
+    LOG_INFO("module", "ChallengeSystem: recording hook trace to '{}'.", path);
+    return true;
+}
+
+void ChallengeTraceRecorder::Stop()
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_file)
+        return;
+
+    _recording.store(false, std::memory_order_relaxed);
+    FlushLocked();
+    std::fclose(_file);
+    _file = nullptr;
+
+    LOG_INFO("module", "ChallengeSystem: hook trace '{}' closed ({} records).", _path,
+        _recordCount.load(std::memory_order_relaxed));
+}
+
+void ChallengeTraceRecorder::Record(ChallengeTraceHook hook, uint32 guid, uint32 arg0, uint32 arg1)
+{
+    if (!IsRecording())
+        return;
+
+    std::lock_guard<std::mutex> guard(_lock);
+    if (!_file)
+        return;
+
+    auto elapsed = std::chrono::steady_clock::now() - _startedAt;
+    uint32 timeMs = static_cast<uint32>(std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    AppendLocked(hook, timeMs, guid, arg0, arg1);
+}
+
+void ChallengeTraceRecorder::AppendLocked(ChallengeTraceHook hook, uint32 timeMs, uint32 guid, uint32 arg0, uint32 arg1)
+{
+    size_t offset = _buffer.size();
+    _buffer.resize(offset + kRecordSize);
+    uint8* out = _buffer.data() + offset;
+    PutUInt32(out, timeMs);
+    PutUInt32(out + 4, guid);
+    PutUInt32(out + 8, arg0);
+    PutUInt32(out + 12, arg1);
+    out[16] = static_cast<uint8>(hook);
+
+    _recordCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (_buffer.size() >= kFlushThreshold)
+        FlushLocked();
+}
+
+std::string ChallengeTraceRecorder::GetPath() const
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    return _path;
+}
+
+void ChallengeTraceRecorder::FlushLocked()
+{
+    if (!_file || _buffer.empty())
+        return;
+
+    std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+    _buffer.clear();
+}
+
+bool ChallengeTraceRecorder::ResolvePath(std::string const& directory, std::string_view name, std::string& path)
+{
+    std::filesystem::path relative(name);
+    if (relative.empty() || relative.has_root_path())
+        return false;
+
+    for (std::filesystem::path const& component : relative)
+    {
+        if (component == "..")
+            return false;
+    }
+
+    path = (std::filesystem::path(directory) / relative).lexically_normal().string();
+    return true;
+}
+
+bool ChallengeTraceRecorder::Load(std::string const& path, std::vector<ChallengeTraceRecord>& records)
+{
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+        return false;
+
+    uint8 header[kHeaderSize];
+    if (std::fread(header, 1, sizeof(header), file) != sizeof(header) ||
+        std::memcmp(header, kTraceMagic, sizeof(kTraceMagic)) != 0 || GetUInt32(header + 4) != kTraceVersion)
+    {
+        std::fclose(file);
+        return false;
+    }
+
+    records.clear();
+    uint8 in[kRecordSize];
+    while (std::fread(in, 1, sizeof(in), file) == sizeof(in))
+    {
+        if (in[16] >= static_cast<uint8>(ChallengeTraceHook::Count))
+            continue;
+
+        ChallengeTraceRecord& record = records.emplace_back();
+        record.timeMs = GetUInt32(in);
+        record.guid = GetUInt32(in + 4);
+        record.arg0 = GetUInt32(in + 8);
+        record.arg1 = GetUInt32(in + 12);
+        record.hook = static_cast<ChallengeTraceHook>(in[16]);
+    }
+
+    std::fclose(file);
+    return true;
+}
+
+char const* ChallengeTraceRecorder::GetHookName(ChallengeTraceHook hook)
+{
+    size_t index = static_cast<size_t>(hook);
+    return index < std::size(kHookNames) ? kHookNames[index] : "unknown";
+}
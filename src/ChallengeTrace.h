@@ -0,0 +1,121 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_H
+
+#include "Define.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Hook invocations captured by ChallengeTraceRecorder. Values are stored in
+ * trace files; append new hooks before Count and never reorder.
+ */
+enum class ChallengeTraceHook : uint8
+{
+    Login = 0,
+    Logout,
+    Update,            // arg0 = diff
+    GroupInvite,       // arg0 = invitee guid (0 if offline)
+    GroupAccept,       // arg0 = group guid (0 while forming), arg1 = LFG group
+    Trade,             // arg0 = other player guid
+    MailSend,
+    MailReceive,       // guid = receiver of a player's mail
+    Auction,
+    EquipItem,         // arg0 = item entry, arg1 = PackEquip()
+    MoneyChanged,      // arg0 = amount (int32), arg1 = money before
+    TalentPoints,      // arg0 = points
+    GiveXP,            // arg0 = amount, arg1 = xp source
+    QuestXP,           // arg0 = xp
+    Summon,            // arg0 = summoner guid (0 if none)
+    Death,             // arg0 = 1 if it counted as a permadeath
+    GuildBank,
+    MountCast,         // arg0 = spell id
+    AuraApply,         // arg0 = spell id
+    AuraRemove,        // arg0 = spell id
+    BotChat,           // arg0 = 1 for a combat command, arg1 = restricted bot it addresses (0 if none)
+    StateChanged,      // arg0 = tier, arg1 = published flags
+    GroupCreate,       // guid = leader, arg0 = group guid
+    GroupAddMember,    // arg0 = group guid
+    GroupRemoveMember, // arg0 = group guid
+    GroupChangeLeader, // guid = new leader, arg0 = group guid
+    GroupDisband,      // guid = 0, arg0 = group guid
+    Count
+};
+
+struct ChallengeTraceRecord
+{
+    uint32 timeMs = 0; // since recording started
+    uint32 guid = 0;
+    uint32 arg0 = 0;
+    uint32 arg1 = 0;
+    ChallengeTraceHook hook = ChallengeTraceHook::Count;
+
+    // EquipItem arg1: slot, item quality and whether this character crafted it.
+    static uint32 PackEquip(uint8 slot, uint32 quality, bool selfCrafted)
+    {
+        return slot | ((quality & 0xFF) << 8) | (uint32(selfCrafted) << 16);
+    }
+
+    uint32 GetEquipQuality() const { return (arg1 >> 8) & 0xFF; }
+    bool IsEquipSelfCrafted() const { return (arg1 >> 16) & 1; }
+};
+
+/**
+ * ChallengeTraceRecorder
+ *
+ * Opt-in recorder for hook traffic (ChallengeSystem.Trace.Enable or
+ * `.ipchallenge trace start`), writing under ChallengeSystem.Trace.Directory.
+ * Each hook appends a fixed 17-byte little-endian record to an in-memory
+ * buffer that is written to the trace file in 64 KB chunks, and on Stop.
+ * When not recording a hook pays one relaxed atomic load.
+ *
+ * A trace opens with the contents of ChallengeStateIndex and
+ * ChallengeGroupIndex as StateChanged and GroupAddMember records at time 0,
+ * so a replay (tests/replay) starts from the state the recording started in.
+ *
+ * Record may be called from any map thread.
+ */
+class ChallengeTraceRecorder
+{
+public:
+    static ChallengeTraceRecorder& Instance();
+
+    bool IsRecording() const { return _recording.load(std::memory_order_relaxed); }
+    bool Start(std::string const& path);
+    void Stop();
+
+    void Record(ChallengeTraceHook hook, uint32 guid, uint32 arg0 = 0, uint32 arg1 = 0);
+
+    uint64 GetRecordCount() const { return _recordCount.load(std::memory_order_relaxed); }
+    std::string GetPath() const;
+
+    // Joins a trace file name onto the trace directory. False for an empty or
+    // absolute name, or one with a `..` component, so a command argument cannot
+    // reach files outside the directory.
+    static bool ResolvePath(std::string const& directory, std::string_view name, std::string& path);
+
+    // Reads a whole trace file; false on a missing file or bad header.
+    static bool Load(std::string const& path, std::vector<ChallengeTraceRecord>& records);
+    static char const* GetHookName(ChallengeTraceHook hook);
+
+private:
+    ChallengeTraceRecorder() = default;
+
+    void AppendLocked(ChallengeTraceHook hook, uint32 timeMs, uint32 guid, uint32 arg0, uint32 arg1);
+    void FlushLocked();
+
+    mutable std::mutex _lock;
+    std::atomic<bool> _recording{ false };
+    std::atomic<uint64> _recordCount{ 0 };
+    std::FILE* _file = nullptr;
+    std::string _path;
+    std::vector<uint8> _buffer;
+    std::chrono::steady_clock::time_point _startedAt;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_H
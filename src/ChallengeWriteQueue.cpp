@@ -0,0 +1,144 @@
+#include "ChallengeWriteQueue.h"
+#include "ChallengeConfig.h"
+#include "ChallengeDatabase.h"
+#include "Log.h"
+
+namespace
+{
+// ip_challenge_runs.state values
+constexpr uint8 kRunStateActive = 2;
+constexpr uint8 kRunStateFailed = 3;
+}
+
+ChallengeWriteQueue& ChallengeWriteQueue::Instance()
+{
+    static ChallengeWriteQueue instance;
+    return instance;
+}
+
+void ChallengeWriteQueue::QueueState(uint32 guid, uint8 tier, uint32 flags, uint32 updatedAt)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    _pending[guid].state = StateWrite{ tier, flags, updatedAt };
+}
+
+void ChallengeWriteQueue::QueueRunActive(uint32 guid, uint8 tier, uint32 pickedFlags, uint32 startedAt)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    PendingWrites& pending = _pending[guid];
+
+    // A new run resets failed_flags and ended_at, so an older failure is moot.
+    pending.runActive = RunActiveWrite{ tier, pickedFlags, startedAt };
+    pending.runFailed.reset();
+}
+
+void ChallengeWriteQueue::QueueRunFailed(uint32 guid, uint8 tier, uint32 pickedFlags, uint32 failedFlags, uint32 endedAt)
+{
+    std::lock_guard<std::mutex> guard(_lock);
+    PendingWrites& pending = _pending[guid];
+
+    // The row accumulates failed_flags, so merge rather than overwrite.
+    if (pending.runFailed)
+        failedFlags |= pending.runFailed->failedFlags;
+
+    pending.runFailed = RunFailedWrite{ tier, pickedFlags, failedFlags, endedAt };
+}
+
+void ChallengeWriteQueue::WritePermadeath(uint32 guid, PermadeathRecord const& record)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+
+    ChallengeDatabasePreparedStatement* stmt = database.GetPreparedStatement(CHALLENGE_INS_PERMADEATH);
+    stmt->SetData(0, guid);
+    stmt->SetData(1, record.deathTime);
+    stmt->SetData(2, record.mapId);
+    stmt->SetData(3, record.x);
+    stmt->SetData(4, record.y);
+    stmt->SetData(5, record.z);
+    stmt->SetData(6, record.o);
+    stmt->SetData(7, record.reason);
+
+    ChallengeDatabaseTransaction trans = database.BeginTransaction();
+    trans->Append(stmt);
+    database.CommitTransaction(trans);
+}
+
+void ChallengeWriteQueue::Update(uint32 diff)
+{
+    _flushTimer += diff;
+    if (_flushTimer < ChallengeConfig::Current().persistenceFlushIntervalMs)
+        return;
+
+    _flushTimer = 0;
+    Flush(false);
+}
+
+void ChallengeWriteQueue::Flush(bool direct)
+{
+    std::unordered_map<uint32, PendingWrites> pending;
+    {
+        std::lock_guard<std::mutex> guard(_lock);
+        if (_pending.empty())
+            return;
+
+        pending.swap(_pending);
+    }
+
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+    ChallengeDatabaseTransaction trans = database.BeginTransaction();
+
+    for (auto const& [guid, writes] : pending)
+    {
+        if (writes.state)
+        {
+            if (writes.state->tier == 0)
+            {
+                ChallengeDatabasePreparedStatement* stmt = database.GetPreparedStatement(CHALLENGE_DEL_STATE);
+                stmt->SetData(0, guid);
+                trans->Append(stmt);
+            }
+            else
+            {
+                ChallengeDatabasePreparedStatement* stmt = database.GetPreparedStatement(CHALLENGE_REP_STATE);
+                stmt->SetData(0, guid);
+                stmt->SetData(1, writes.state->tier);
+                stmt->SetData(2, writes.state->flags);
+                stmt->SetData(3, writes.state->updatedAt);
+                trans->Append(stmt);
+            }
+        }
+
+        // Active before failed: a run started and failed within one window ends up failed.
+        if (writes.runActive)
+        {
+            ChallengeDatabasePreparedStatement* stmt = database.GetPreparedStatement(CHALLENGE_INS_RUN_ACTIVE);
+            stmt->SetData(0, guid);
+            stmt->SetData(1, writes.runActive->tier);
+            stmt->SetData(2, kRunStateActive);
+            stmt->SetData(3, writes.runActive->pickedFlags);
+            stmt->SetData(4, writes.runActive->startedAt);
+            trans->Append(stmt);
+        }
+
+        if (writes.runFailed)
+        {
+            ChallengeDatabasePreparedStatement* stmt = database.GetPreparedStatement(CHALLENGE_INS_RUN_FAILED);
+            stmt->SetData(0, guid);
+            stmt->SetData(1, writes.runFailed->tier);
+            stmt->SetData(2, kRunStateFailed);
+            stmt->SetData(3, writes.runFailed->pickedFlags);
+            stmt->SetData(4, writes.runFailed->failedFlags);
+            stmt->SetData(5, writes.runFailed->endedAt);
+            trans->Append(stmt);
+        }
+    }
+
+    size_t statementCount = trans->GetSize();
+    if (direct)
+        database.DirectCommitTransaction(trans);
+    else
+        database.CommitTransaction(trans);
+
+    LOG_DEBUG("module", "ChallengeSystem: flushed writes for {} characters ({} statements)",
+        pending.size(), statementCount);
+}
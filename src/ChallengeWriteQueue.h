@@ -0,0 +1,90 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_WRITE_QUEUE_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_WRITE_QUEUE_H
+
+#include "Define.h"
+#include "Optional.h"
+
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * ChallengeWriteQueue
+ *
+ * Write-behind buffer for challenge state and run rows. Writes are
+ * coalesced per guid so only the latest state survives, and the world
+ * thread flushes everything pending every
+ * ChallengeSystem.Persistence.FlushIntervalMs, and once more synchronously
+ * at shutdown, as one transaction of single-row prepared statements that
+ * ChallengeDatabase's writer thread executes.
+ *
+ * Permadeath rows are the exception: a crash inside the flush window must
+ * not bring a character back, so WritePermadeath commits its row at once in
+ * its own transaction.
+ *
+ * Producers may run on any map thread. Nothing reads these tables back at
+ * runtime (ChallengeStateIndex and ChallengePermadeathIndex are updated
+ * immediately), so buffered rows are never observed stale.
+ */
+class ChallengeWriteQueue
+{
+public:
+    struct PermadeathRecord
+    {
+        uint32 deathTime = 0;
+        uint32 mapId = 0;
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+        float o = 0.0f;
+        uint8 reason = 0;
+    };
+
+    static ChallengeWriteQueue& Instance();
+
+    // tier 0 deletes the ip_challenge_state row.
+    void QueueState(uint32 guid, uint8 tier, uint32 flags, uint32 updatedAt);
+    void QueueRunActive(uint32 guid, uint8 tier, uint32 pickedFlags, uint32 startedAt);
+    void QueueRunFailed(uint32 guid, uint8 tier, uint32 pickedFlags, uint32 failedFlags, uint32 endedAt);
+    void WritePermadeath(uint32 guid, PermadeathRecord const& record);
+
+    void Update(uint32 diff);
+    void Flush(bool direct);
+
+private:
+    ChallengeWriteQueue() = default;
+
+    struct StateWrite
+    {
+        uint8 tier = 0;
+        uint32 flags = 0;
+        uint32 updatedAt = 0;
+    };
+
+    struct RunActiveWrite
+    {
+        uint8 tier = 0;
+        uint32 pickedFlags = 0;
+        uint32 startedAt = 0;
+    };
+
+    struct RunFailedWrite
+    {
+        uint8 tier = 0;
+        uint32 pickedFlags = 0;
+        uint32 failedFlags = 0;
+        uint32 endedAt = 0;
+    };
+
+    struct PendingWrites
+    {
+        Optional<StateWrite> state;
+        Optional<RunActiveWrite> runActive;
+        Optional<RunFailedWrite> runFailed;
+    };
+
+    std::mutex _lock;
+    std::unordered_map<uint32, PendingWrites> _pending;
+    uint32 _flushTimer = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_WRITE_QUEUE_H
@@ -0,0 +1,9 @@
+#include "AccessRestrictions.h"
+#include "Player.h"
+
+bool NoSummonsRestriction::OnSummonAccept(Player* player, Unit* summoner)
+{
+    // Summon teleports pass the summoner as target; other teleports often do not.
+    // TODO: Extend detection if additional summon/portal sources need coverage.
+    return !summoner || summoner == player;
+}
@@ -0,0 +1,60 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_ACCESS_RESTRICTIONS_H
+#define MOD_IP_CHALLENGESYSTEM_ACCESS_RESTRICTIONS_H
+
+#include "ChallengeRestriction.h"
+
+/**
+ * Restrictions that cut a character off from a game system outright:
+ * being in force is the whole check.
+ */
+
+class NoTradeRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::NoTrade; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::Trade); }
+
+    bool OnTradeAttempt(Player* /*player*/, Player* /*other*/) override { return false; }
+};
+
+class NoMailRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::NoMail; }
+    uint32 GetHooks() const override
+    {
+        return RestrictionHookMask(RestrictionHook::MailSend) | RestrictionHookMask(RestrictionHook::MailReceive);
+    }
+
+    bool OnMailSend(Player* /*player*/) override { return false; }
+    bool OnMailReceive(uint32 /*receiverGuid*/) override { return false; }
+};
+
+class NoAuctionRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::NoAuction; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::Auction); }
+
+    bool OnAuctionAction(Player* /*player*/) override { return false; }
+};
+
+class NoGuildBankRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::NoGuildBank; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::GuildBank); }
+
+    bool OnGuildBankAccess(Player* /*player*/) override { return false; }
+};
+
+class NoSummonsRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::NoSummons; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::Summon); }
+
+    bool OnSummonAccept(Player* player, Unit* summoner) override;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_ACCESS_RESTRICTIONS_H
@@ -0,0 +1,17 @@
+#include "EquipmentRestrictions.h"
+#include "ChallengeConfig.h"
+#include "Item.h"
+#include "Player.h"
+#include "UpdateFields.h"
+
+bool LowQualityOnlyRestriction::OnEquipItem(Player* /*player*/, Item* item)
+{
+    ItemTemplate const* proto = item->GetTemplate();
+    return proto && proto->Quality <= ChallengeConfig::Current().lowQualityMaxQuality;
+}
+
+bool SelfCraftedRestriction::OnEquipItem(Player* player, Item* item)
+{
+    // Missing creator GUID means the item wasn't crafted by this character.
+    return item->GetGuidValue(ITEM_FIELD_CREATOR) == player->GetGUID();
+}
@@ -0,0 +1,29 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_EQUIPMENT_RESTRICTIONS_H
+#define MOD_IP_CHALLENGESYSTEM_EQUIPMENT_RESTRICTIONS_H
+
+#include "ChallengeRestriction.h"
+
+/**
+ * Restrictions on what a character may equip. Both also apply to gear that
+ * is already equipped, through ChallengeManager::EnforceEquipmentRestrictions.
+ */
+
+class LowQualityOnlyRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::LowQualityOnly; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::EquipItem); }
+
+    bool OnEquipItem(Player* player, Item* item) override;
+};
+
+class SelfCraftedRestriction final : public ChallengeRestriction
+{
+public:
+    RestrictionId GetRestrictionId() const override { return RestrictionId::SelfCrafted; }
+    uint32 GetHooks() const override { return RestrictionHookMask(RestrictionHook::EquipItem); }
+
+    bool OnEquipItem(Player* player, Item* item) override;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_EQUIPMENT_RESTRICTIONS_H
@@ -0,0 +1,16 @@
+#include "AccessRestrictions.h"
+#include "EquipmentRestrictions.h"
+
+#include <memory>
+
+void AddChallengeSystemRestrictions()
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    manager.RegisterRestriction(std::make_shared<NoTradeRestriction>());
+    manager.RegisterRestriction(std::make_shared<NoMailRestriction>());
+    manager.RegisterRestriction(std::make_shared<NoAuctionRestriction>());
+    manager.RegisterRestriction(std::make_shared<NoGuildBankRestriction>());
+    manager.RegisterRestriction(std::make_shared<NoSummonsRestriction>());
+    manager.RegisterRestriction(std::make_shared<LowQualityOnlyRestriction>());
+    manager.RegisterRestriction(std::make_shared<SelfCraftedRestriction>());
+}
@@ -1,9 +1,12 @@
 #include "ChallengeManager.h"
+#include "ChallengeConfig.h"
+#include "ChallengeDatabase.h"
+#include "ChallengeTrace.h"
 #include "Chat.h"
 #include "CommandScript.h"
-#include "Config.h"
 #include "Guild.h"
 #include "GuildMgr.h"
+#include "Log.h"
 #include "Player.h"
 #include "StringConvert.h"
 
@@ -141,6 +144,30 @@ std::string DescribeFlags(uint32 flags)
 
     return result;
 }
+
+char const* DescribeStatementKind(ChallengeDatabase::StatementKind kind)
+{
+    switch (kind)
+    {
+        case ChallengeDatabase::StatementKind::Query:
+            return "query";
+        case ChallengeDatabase::StatementKind::Execute:
+            return "exec";
+    }
+    return "?";
+}
+
+// Resolves a trace name (default ChallengeSystem.Trace.File) under ChallengeSystem.Trace.Directory.
+bool ResolveTracePath(ChatHandler* handler, Optional<std::string_view> name, std::string& path)
+{
+    ChallengeConfig const& config = ChallengeConfig::Current();
+    std::string_view file = name ? *name : std::string_view(config.traceFile);
+    if (ChallengeTraceRecorder::ResolvePath(config.traceDirectory, file, path))
+        return true;
+
+    handler->PSendSysMessage("Trace names are relative to ChallengeSystem.Trace.Directory and may not contain '..': '{}'.", file);
+    return false;
+}
 }
 
 class ip_challenge_commandscript : public CommandScript
@@ -155,7 +182,9 @@ public:
             { "set",         HandleIpChallengeSet,         SEC_GAMEMASTER, Console::No },
             { "clear",       HandleIpChallengeClear,       SEC_GAMEMASTER, Console::No },
             { "status",      HandleIpChallengeStatus,      SEC_GAMEMASTER, Console::No },
-            { "createguild", HandleIpChallengeCreateGuild, SEC_GAMEMASTER, Console::No }
+            { "createguild", HandleIpChallengeCreateGuild, SEC_GAMEMASTER, Console::No },
+            { "sqlstats",    HandleIpChallengeSqlStats,    SEC_ADMINISTRATOR, Console::Yes },
+            { "trace",       HandleIpChallengeTrace,       SEC_ADMINISTRATOR, Console::Yes }
         };
 
         static ChatCommandTable commandTable =
@@ -207,6 +236,13 @@ public:
 
         handler->PSendSysMessage("Active challenge set for {}: tier {} flags {} ({})",
             player->GetName(), tier, flags, DescribeFlags(flags));
+
+        ChallengeManager::EquipmentEnforcement equipment = ChallengeManager::Instance().EnforceEquipmentRestrictions(player);
+        if (equipment.Total())
+        {
+            handler->PSendSysMessage("Unequipped {} restricted item(s): {} moved to bags, {} mailed in {} mail(s).",
+                equipment.Total(), equipment.stored, equipment.mailed, equipment.mails);
+        }
         return true;
     }
 
@@ -242,7 +278,7 @@ public:
         if (!player)
             return false;
 
-        std::string guildName = sConfigMgr->GetOption<std::string>("ChallengeSystem.Hardcore.GuildName", "");
+        std::string const& guildName = ChallengeConfig::Current().hardcoreGuildName;
         if (guildName.empty())
         {
             handler->SendSysMessage("ChallengeSystem.Hardcore.GuildName is not set.");
@@ -273,6 +309,73 @@ public:
         handler->PSendSysMessage("Guild '{}' created. {} is now guild leader.", guildName, player->GetName());
         return true;
     }
+
+    static bool HandleIpChallengeSqlStats(ChatHandler* handler, Optional<std::string_view> action)
+    {
+        if (action)
+        {
+            if (*action != "reset")
+            {
+                handler->SendSysMessage("Usage: .ipchallenge sqlstats [reset]");
+                return false;
+            }
+
+            ChallengeDatabase::Instance().ResetStats();
+            handler->SendSysMessage("Challenge SQL statistics reset.");
+            return true;
+        }
+
+        handler->SendSysMessage("Statement | kind | calls | total ms | avg us | max us");
+        for (ChallengeDatabase::StatementStats const& stats : ChallengeDatabase::Instance().GetStats())
+        {
+            if (!stats.calls)
+                continue;
+
+            handler->PSendSysMessage("{} | {} | {} | {:.2f} | {} | {}", stats.name, DescribeStatementKind(stats.kind),
+                stats.calls, stats.totalMicros / 1000.0, stats.totalMicros / stats.calls, stats.maxMicros);
+        }
+        return true;
+    }
+
+    static bool HandleIpChallengeTrace(ChatHandler* handler, Optional<std::string_view> action)
+    {
+        ChallengeTraceRecorder& recorder = ChallengeTraceRecorder::Instance();
+        if (!action)
+        {
+            if (recorder.IsRecording())
+                handler->PSendSysMessage("Recording hook trace to '{}': {} records.", recorder.GetPath(), recorder.GetRecordCount());
+            else
+                handler->SendSysMessage("Hook trace is not recording.");
+            return true;
+        }
+
+        if (*action == "start")
+        {
+            std::string path;
+            if (!ResolveTracePath(handler, std::nullopt, path))
+                return false;
+
+            if (!recorder.Start(path))
+            {
+                handler->PSendSysMessage("Could not start recording to '{}' (already recording, or the file cannot be opened).", path);
+                return false;
+            }
+
+            handler->PSendSysMessage("Recording hook trace to '{}'.", path);
+            return true;
+        }
+
+        if (*action == "stop")
+        {
+            uint64 records = recorder.GetRecordCount();
+            recorder.Stop();
+            handler->PSendSysMessage("Hook trace stopped ({} records).", records);
+            return true;
+        }
+
+        handler->SendSysMessage("Usage: .ipchallenge trace [start|stop]");
+        return false;
+    }
 };
 
 void AddChallengeSystemCommands()
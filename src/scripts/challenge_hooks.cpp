@@ -1,217 +1,193 @@
 #include "ChallengeManager.h"
+#include "ChallengeAccountIndex.h"
+#include "ChallengeConfig.h"
+#include "ChallengeDatabase.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengePermadeathIndex.h"
+#include "ChallengeSpellTable.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTrace.h"
+#include "ChallengeWriteQueue.h"
 #include "AuctionHouseMgr.h"
-#include "AccountMgr.h"
+#include "AllCommandScript.h"
+#include "AllSpellScript.h"
 #include "Chat.h"
-#include "CharacterCache.h"
-#include "Creature.h"
 #include "Config.h"
-#include "DatabaseEnv.h"
+#include "Creature.h"
 #include "Duration.h"
-#include "GameTime.h"
 #include "Group.h"
+#include "GroupScript.h"
 #include "GuildScript.h"
+#include "Item.h"
+#include "Log.h"
 #include "Mail.h"
-#include "MailScript.h"
 #include "MiscScript.h"
 #include "ObjectAccessor.h"
-#include "Opcodes.h"
 #include "Player.h"
 #include "ScriptMgr.h"
-#include "ServerScript.h"
-
-#include <cctype>
-#include <sstream>
+#include "Spell.h"
+#include "SpellAuras.h"
+#include "SpellInfo.h"
+#include "UnitScript.h"
+#include "UpdateFields.h"
+#include "Util.h"
+#include "WorldScript.h"
+
+#include <string>
+#include <string_view>
 #include <vector>
 
 void AddChallengeSystemCommands();
+void AddChallengeSystemRestrictions();
 
 namespace
 {
-std::string GetConfigMessage(char const* key, char const* fallback)
+// Records the hook call when tracing; a single relaxed load otherwise.
+void Trace(ChallengeTraceHook hook, Player const* player, uint32 arg0 = 0, uint32 arg1 = 0)
 {
-    return sConfigMgr->GetOption<std::string>(key, fallback);
+    ChallengeTraceRecorder& recorder = ChallengeTraceRecorder::Instance();
+    if (recorder.IsRecording() && player)
+        recorder.Record(hook, player->GetGUID().GetCounter(), arg0, arg1);
 }
 
-void SendPlayerError(Player* player, std::string const& message)
+void SendPlayerError(Player* player, ChallengeMessage message)
 {
     if (!player || !player->GetSession())
         return;
 
-    ChatHandler(player->GetSession()).SendSysMessage(message.c_str());
+    ChatHandler(player->GetSession()).SendSysMessage(ChallengeConfig::Current().GetMessage(message).c_str());
 }
 
-void SendPlayerNotification(Player* player, std::string const& message)
+void SendPlayerNotification(Player* player, ChallengeMessage message)
 {
     if (!player || !player->GetSession())
         return;
 
-    ChatHandler(player->GetSession()).SendNotification(message.c_str());
+    ChatHandler(player->GetSession()).SendNotification(ChallengeConfig::Current().GetMessage(message).c_str());
 }
 
-std::vector<std::string> SplitWhitespace(std::string const& input)
+void StartConfiguredTrace(ChallengeConfig const& config)
 {
-    std::istringstream iss(input);
-    std::vector<std::string> tokens;
-    std::string token;
-    while (iss >> token)
-        tokens.push_back(token);
-    return tokens;
-}
-
-std::vector<std::string> SplitComma(std::string const& input)
-{
-    std::vector<std::string> tokens;
-    std::string current;
-    for (char c : input)
+    std::string path;
+    if (!ChallengeTraceRecorder::ResolvePath(config.traceDirectory, config.traceFile, path))
     {
-        if (c == ',')
-        {
-            if (!current.empty())
-                tokens.push_back(current);
-            current.clear();
-            continue;
-        }
-        current.push_back(c);
+        LOG_ERROR("module", "ChallengeSystem: ChallengeSystem.Trace.File '{}' must be a relative name without '..'.", config.traceFile);
+        return;
     }
-    if (!current.empty())
-        tokens.push_back(current);
-    return tokens;
+
+    ChallengeTraceRecorder::Instance().Start(path);
 }
 
-std::string ToLower(std::string value)
-{
-    for (char& c : value)
-        c = static_cast<char>(std::tolower(c));
-    return value;
 }
 
-bool ExtractChatMessage(WorldPacket& packet, uint32 type, uint32 lang, std::string& outMsg)
+class ChallengeSystemWorldHooks : public WorldScript
 {
-    try
-    {
-        switch (type)
-        {
-            case CHAT_MSG_SAY:
-            case CHAT_MSG_YELL:
-            case CHAT_MSG_PARTY:
-            case CHAT_MSG_RAID:
-            case CHAT_MSG_GUILD:
-            case CHAT_MSG_OFFICER:
-            case CHAT_MSG_EMOTE:
-            case CHAT_MSG_TEXT_EMOTE:
-            case CHAT_MSG_RAID_LEADER:
-            case CHAT_MSG_RAID_WARNING:
-            case CHAT_MSG_BATTLEGROUND:
-            case CHAT_MSG_BATTLEGROUND_LEADER:
-            case CHAT_MSG_PARTY_LEADER:
-            case CHAT_MSG_WHISPER:
-            {
-                if (type == CHAT_MSG_WHISPER)
-                {
-                    std::string to;
-                    packet >> to;
-                }
-                outMsg = packet.ReadCString(lang != LANG_ADDON);
-                return true;
-            }
-            case CHAT_MSG_CHANNEL:
-            {
-                std::string channel;
-                packet >> channel;
-                outMsg = packet.ReadCString(lang != LANG_ADDON);
-                return true;
-            }
-            case CHAT_MSG_AFK:
-            case CHAT_MSG_DND:
-            {
-                outMsg = packet.ReadCString(lang != LANG_ADDON);
-                return true;
-            }
-            default:
-                return false;
-        }
-    }
-    catch (...)
+public:
+    ChallengeSystemWorldHooks() : WorldScript("ip_challengesystem_world",
+        { WORLDHOOK_ON_AFTER_CONFIG_LOAD, WORLDHOOK_ON_STARTUP, WORLDHOOK_ON_UPDATE, WORLDHOOK_ON_SHUTDOWN }) {}
+
+    void OnAfterConfigLoad(bool reload) override
     {
-        return false;
-    }
-}
+        ChallengeConfig::Reload();
 
-bool IsHardcoreBotAllowed(Player* master, std::string const& name)
-{
-    if (!master)
-        return false;
+        // The first load runs before spells are loaded; OnStartup builds the table then.
+        if (!reload)
+            return;
 
-    ObjectGuid guid = sCharacterCache->GetCharacterGuidByName(name);
-    if (!guid)
-        return false;
+        ChallengeSpellTable::Build(ChallengeConfig::Current());
 
-    return ChallengeManager::Instance().IsHardcoreGuid(guid.GetCounter());
-}
+        ChallengeConfig const& config = ChallengeConfig::Current();
+        if (config.traceEnabled)
+            StartConfiguredTrace(config);
+        else
+            ChallengeTraceRecorder::Instance().Stop();
+    }
 
-bool AreAccountBotsHardcore(std::string const& accountOrCharacter)
-{
-    uint32 accountId = AccountMgr::GetId(accountOrCharacter);
-    if (!accountId)
+    void OnStartup() override
     {
-        ObjectGuid guid = sCharacterCache->GetCharacterGuidByName(accountOrCharacter);
-        if (!guid)
-            return false;
-        accountId = sCharacterCache->GetCharacterAccountIdByGuid(guid);
+        ChallengeSpellTable::Build(ChallengeConfig::Current());
+        ChallengeDatabase::Instance().Open(sConfigMgr->GetOption<std::string>("CharacterDatabaseInfo", ""));
+        ChallengePermadeathIndex::Instance().LoadFromDB();
+        ChallengeStateIndex::Instance().LoadFromDB();
+        ChallengeAccountIndex::Instance().LoadFromDB();
+
+        if (ChallengeConfig::Current().traceEnabled)
+            StartConfiguredTrace(ChallengeConfig::Current());
     }
 
-    if (!accountId)
-        return false;
+    void OnUpdate(uint32 diff) override
+    {
+        ChallengeManager::Instance().UpdateTimers(diff);
+        ChallengeWriteQueue::Instance().Update(diff);
+        ChallengeConfig::ReclaimRetired();
+        ChallengeSpellTable::ReclaimRetired();
+    }
+
+    void OnShutdown() override
+    {
+        ChallengeWriteQueue::Instance().Flush(true);
+        ChallengeDatabase::Instance().Close();
+        ChallengeTraceRecorder::Instance().Stop();
+    }
+};
 
-    QueryResult result = CharacterDatabase.Query(
-        "SELECT guid FROM characters WHERE account = {}", accountId);
-    if (!result)
-        return false;
+class ChallengeSystemPlayerHooks : public PlayerScript
+{
+public:
+    ChallengeSystemPlayerHooks() : PlayerScript("ip_challengesystem_player",
+        { PLAYERHOOK_ON_LOGIN, PLAYERHOOK_ON_LOGOUT, PLAYERHOOK_ON_UPDATE }) {}
 
-    do
+    void OnPlayerLogin(Player* player) override
     {
-        Field* fields = result->Fetch();
-        uint32 guid = fields[0].Get<uint32>();
-        if (!ChallengeManager::Instance().IsHardcoreGuid(guid))
-            return false;
-    } while (result->NextRow());
+        Trace(ChallengeTraceHook::Login, player);
+        ChallengeManager::Instance().HandlePlayerLogin(player);
+    }
 
-    return true;
-}
+    void OnPlayerLogout(Player* player) override
+    {
+        Trace(ChallengeTraceHook::Logout, player);
+        ChallengeManager::Instance().HandlePlayerLogout(player);
+    }
 
-}
+    void OnPlayerUpdate(Player* player, uint32 diff) override
+    {
+        Trace(ChallengeTraceHook::Update, player, diff);
+        ChallengeManager::Instance().HandlePlayerUpdate(player, diff);
+    }
+};
 
-class ChallengeSystemHooks : public PlayerScript
+// Restrictions carried by a character's flags; any character may hold them, so these are always on.
+class ChallengeSystemRestrictionHooks : public PlayerScript
 {
 public:
-    ChallengeSystemHooks() : PlayerScript("ip_challengesystem_hooks") {}
+    explicit ChallengeSystemRestrictionHooks(ChallengeConfig const& config)
+        : PlayerScript("ip_challengesystem_restrictions", GetHooks(config)) {}
 
-    void OnPlayerLogin(Player* player) override
+    static std::vector<uint16> GetHooks(ChallengeConfig const& config)
     {
-        if (ChallengeManager::Instance().IsPermadead(player))
+        std::vector<uint16> hooks =
         {
-            SendPlayerNotification(player,
-                GetConfigMessage("ChallengeSystem.Message.Permadeath.Lockout",
-                    "This character is permanently dead. You may keep it as a memorial or delete it."));
-            if (player && player->GetSession())
-            {
-                time_t now = GameTime::GetGameTime().count();
-                player->GetSession()->SetLogoutStartTime(now > 20 ? now - 20 : 0);
-            }
-            return;
-        }
-
-        ChallengeManager::Instance().HandlePlayerLogin(player);
+            PLAYERHOOK_CAN_GROUP_INVITE, PLAYERHOOK_CAN_GROUP_ACCEPT, PLAYERHOOK_CAN_INIT_TRADE,
+            PLAYERHOOK_CAN_SEND_MAIL, PLAYERHOOK_CAN_PLACE_AUCTION_BID, PLAYERHOOK_CAN_EQUIP_ITEM,
+            PLAYERHOOK_ON_BEFORE_TELEPORT, PLAYERHOOK_ON_CALCULATE_TALENTS_POINTS,
+            PLAYERHOOK_ON_BEFORE_INIT_TALENT_FOR_LEVEL, PLAYERHOOK_ON_FREE_TALENT_POINTS_CHANGED,
+            PLAYERHOOK_ON_GIVE_EXP, PLAYERHOOK_ON_QUEST_COMPUTE_EXP
+        };
+
+        // POVERTY is a no-op while every tier's cap is 0.
+        if (config.HasPovertyCap())
+            hooks.push_back(PLAYERHOOK_ON_MONEY_CHANGED);
+
+        return hooks;
     }
 
     bool OnPlayerCanGroupInvite(Player* inviter, std::string& membername) override
     {
         Player* target = ObjectAccessor::FindPlayerByName(membername, false);
+        Trace(ChallengeTraceHook::GroupInvite, inviter, target ? target->GetGUID().GetCounter() : 0);
         if (!ChallengeManager::Instance().HandleGroupInvite(inviter, target))
         {
-            SendPlayerError(inviter,
-                GetConfigMessage("ChallengeSystem.Message.GroupBlocked",
-                    "Grouping is disabled by active Challenge restrictions."));
+            SendPlayerError(inviter, ChallengeMessage::GroupBlocked);
             return false;
         }
 
@@ -220,23 +196,10 @@ public:
 
     bool OnPlayerCanGroupAccept(Player* player, Group* group) override
     {
-        if (group && group->isLFGGroup())
-        {
-            if (!ChallengeManager::Instance().HandleGroupAccept(player, group))
-            {
-                SendPlayerError(player,
-                    GetConfigMessage("ChallengeSystem.Message.GroupBlocked",
-                        "Grouping is disabled by active Challenge restrictions."));
-                return false;
-            }
-            return true;
-        }
-
+        Trace(ChallengeTraceHook::GroupAccept, player, group ? group->GetGUID().GetCounter() : 0, group && group->isLFGGroup());
         if (!ChallengeManager::Instance().HandleGroupAccept(player, group))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.GroupBlocked",
-                    "Grouping is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::GroupBlocked);
             return false;
         }
 
@@ -245,26 +208,31 @@ public:
 
     bool OnPlayerCanInitTrade(Player* player, Player* target) override
     {
+        Trace(ChallengeTraceHook::Trade, player, target ? target->GetGUID().GetCounter() : 0);
         if (!ChallengeManager::Instance().HandleTradeAttempt(player, target))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.TradeBlocked",
-                    "Trading is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::TradeBlocked);
             return false;
         }
 
         return true;
     }
 
-    bool OnPlayerCanSendMail(Player* player, ObjectGuid /*receiverGuid*/, ObjectGuid /*mailbox*/,
+    // Player-to-player mail only: runs before the core takes money or items from the sender,
+    // so a refused mail leaves nothing behind. System mail (auctions, returns, quests, GMs)
+    // is never blocked.
+    bool OnPlayerCanSendMail(Player* player, ObjectGuid receiverGuid, ObjectGuid /*mailbox*/,
                              std::string& /*subject*/, std::string& /*body*/, uint32 /*money*/, uint32 /*COD*/,
                              Item* /*item*/) override
     {
-        if (!ChallengeManager::Instance().HandleMailSend(player))
+        Trace(ChallengeTraceHook::MailSend, player);
+        ChallengeTraceRecorder::Instance().Record(ChallengeTraceHook::MailReceive, receiverGuid.GetCounter());
+
+        // Offline receivers resolve through ChallengeStateIndex like online ones.
+        if (!ChallengeManager::Instance().HandleMailSend(player) ||
+            !ChallengeManager::Instance().HandleMailReceive(receiverGuid.GetCounter()))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.MailBlocked",
-                    "Mail is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::MailBlocked);
             return false;
         }
 
@@ -273,29 +241,29 @@ public:
 
     bool OnPlayerCanPlaceAuctionBid(Player* player, AuctionEntry* /*auction*/) override
     {
+        Trace(ChallengeTraceHook::Auction, player);
         if (!ChallengeManager::Instance().HandleAuctionAction(player))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.AuctionBlocked",
-                    "Auction House access is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::AuctionBlocked);
             return false;
         }
 
         return true;
     }
 
-    void OnPlayerLogout(Player* player) override
-    {
-        ChallengeManager::Instance().HandlePlayerLogout(player);
-    }
-
     bool OnPlayerCanEquipItem(Player* player, uint8 slot, uint16& /*dest*/, Item* pItem, bool /*swap*/, bool /*not_loading*/) override
     {
+        if (ChallengeTraceRecorder::Instance().IsRecording() && pItem)
+        {
+            ItemTemplate const* proto = pItem->GetTemplate();
+            bool selfCrafted = pItem->GetGuidValue(ITEM_FIELD_CREATOR) == player->GetGUID();
+            Trace(ChallengeTraceHook::EquipItem, player, pItem->GetEntry(),
+                ChallengeTraceRecord::PackEquip(slot, proto ? proto->Quality : 0, selfCrafted));
+        }
+
         if (!ChallengeManager::Instance().HandleEquipItem(player, pItem, slot, false))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.EquipBlocked",
-                    "Equipping this item is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::EquipBlocked);
             return false;
         }
 
@@ -304,16 +272,19 @@ public:
 
     void OnPlayerMoneyChanged(Player* player, int32& amount) override
     {
+        Trace(ChallengeTraceHook::MoneyChanged, player, static_cast<uint32>(amount), player->GetMoney());
         ChallengeManager::Instance().HandleMoneyChange(player, amount);
     }
 
     void OnPlayerCalculateTalentsPoints(Player const* player, uint32& points) override
     {
+        Trace(ChallengeTraceHook::TalentPoints, player, points);
         ChallengeManager::Instance().HandleTalentPoints(const_cast<Player*>(player), points);
     }
 
     void OnPlayerBeforeInitTalentForLevel(Player* player, uint8& /*level*/, uint32& talentPointsForLevel) override
     {
+        Trace(ChallengeTraceHook::TalentPoints, player, talentPointsForLevel);
         ChallengeManager::Instance().HandleTalentPoints(player, talentPointsForLevel);
     }
 
@@ -324,18 +295,37 @@ public:
 
     void OnPlayerGiveXP(Player* player, uint32& amount, Unit* /*victim*/, uint8 xpSource) override
     {
+        Trace(ChallengeTraceHook::GiveXP, player, amount, xpSource);
         ChallengeManager::Instance().HandleGiveXP(player, amount, xpSource);
     }
 
     void OnPlayerQuestComputeXP(Player* player, Quest const* /*quest*/, uint32& xpValue) override
     {
+        Trace(ChallengeTraceHook::QuestXP, player, xpValue);
         ChallengeManager::Instance().HandleQuestXP(player, xpValue);
     }
 
-    void OnPlayerUpdate(Player* player, uint32 diff) override
+    bool OnPlayerBeforeTeleport(Player* player, uint32 /*mapid*/, float /*x*/, float /*y*/, float /*z*/,
+                                float /*orientation*/, uint32 options, Unit* target) override
     {
-        ChallengeManager::Instance().HandlePlayerUpdate(player, diff);
+        Trace(ChallengeTraceHook::Summon, player, target ? target->GetGUID().GetCounter() : 0);
+        if (!ChallengeManager::Instance().HandleSummonAccept(player, target, options))
+        {
+            SendPlayerError(player, ChallengeMessage::SummonBlocked);
+            return false;
+        }
+
+        return true;
     }
+};
+
+// Registered only with ChallengeSystem.Permadeath.Enable.
+class ChallengeSystemPermadeathHooks : public PlayerScript
+{
+public:
+    ChallengeSystemPermadeathHooks() : PlayerScript("ip_challengesystem_permadeath",
+        { PLAYERHOOK_CAN_REPOP_AT_GRAVEYARD, PLAYERHOOK_ON_PLAYER_RELEASED_GHOST, PLAYERHOOK_CAN_RESURRECT,
+          PLAYERHOOK_ON_PVP_KILL, PLAYERHOOK_ON_PLAYER_KILLED_BY_CREATURE, PLAYERHOOK_ON_PLAYER_JUST_DIED }) {}
 
     bool OnPlayerCanRepopAtGraveyard(Player* player) override
     {
@@ -355,22 +345,16 @@ public:
         if (!ChallengeManager::Instance().IsPermadeathPending(player))
             return;
 
-        uint32 mapId = sConfigMgr->GetOption<uint32>("ChallengeSystem.Permadeath.GhostMap", 0);
-        float x = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostX", -11075.463f);
-        float y = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostY", -1795.9891f);
-        float z = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostZ", 52.717907f);
-        float o = sConfigMgr->GetOption<float>("ChallengeSystem.Permadeath.GhostO", 0.043097086f);
-
-        player->TeleportTo(mapId, x, y, z, o);
+        ChallengeConfig const& config = ChallengeConfig::Current();
+        player->TeleportTo(config.permadeathGhostMap, config.permadeathGhostX, config.permadeathGhostY,
+            config.permadeathGhostZ, config.permadeathGhostO);
     }
 
     bool OnPlayerCanResurrect(Player* player) override
     {
         if (ChallengeManager::Instance().IsPermadeathPending(player))
         {
-            SendPlayerNotification(player,
-                GetConfigMessage("ChallengeSystem.Message.ResurrectBlocked",
-                    "Resurrection is disabled while permadeath is pending."));
+            SendPlayerNotification(player, ChallengeMessage::ResurrectBlocked);
             return false;
         }
 
@@ -387,30 +371,62 @@ public:
         ChallengeManager::Instance().RecordPvEDeath(killed);
     }
 
-    bool OnPlayerBeforeTeleport(Player* player, uint32 /*mapid*/, float /*x*/, float /*y*/, float /*z*/,
-                                float /*orientation*/, uint32 options, Unit* target) override
+    void OnPlayerJustDied(Player* player) override
     {
-        if (!ChallengeManager::Instance().HandleSummonAccept(player, target, options))
+        bool permadeath = ChallengeManager::Instance().HandleDeath(player);
+        Trace(ChallengeTraceHook::Death, player, permadeath);
+    }
+};
+
+// Player side of the playerbot filter; the command side is ChallengeSystemPlayerbotBlocker.
+class ChallengeSystemPlayerbotHooks : public PlayerScript
+{
+public:
+    explicit ChallengeSystemPlayerbotHooks(ChallengeConfig const& config)
+        : PlayerScript("ip_challengesystem_playerbot", GetHooks(config)) {}
+
+    static std::vector<uint16> GetHooks(ChallengeConfig const& config)
+    {
+        std::vector<uint16> hooks = { PLAYERHOOK_ON_CREATE, PLAYERHOOK_ON_DELETE };
+
+        // Chat lines are only inspected when combat commands are configured.
+        if (config.botCommands.HasKind(BotCommandKind::Combat))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.SummonBlocked",
-                    "Summons are disabled by active Challenge restrictions."));
-            return false;
+            hooks.push_back(PLAYERHOOK_CAN_PLAYER_USE_PRIVATE_CHAT);
+            hooks.push_back(PLAYERHOOK_CAN_PLAYER_USE_GROUP_CHAT);
         }
 
-        return true;
+        return hooks;
     }
 
-    void OnPlayerJustDied(Player* player) override
+    bool OnPlayerCanUseChat(Player* player, uint32 /*type*/, uint32 lang, std::string& msg, Player* receiver) override
+    {
+        return ChallengeManager::Instance().HandleBotChat(player, lang, msg, receiver, nullptr);
+    }
+
+    bool OnPlayerCanUseChat(Player* player, uint32 /*type*/, uint32 lang, std::string& msg, Group* group) override
     {
-        ChallengeManager::Instance().HandleDeath(player);
+        return ChallengeManager::Instance().HandleBotChat(player, lang, msg, nullptr, group);
+    }
+
+    // A new or removed character changes whether its whole account is Hardcore.
+    void OnPlayerCreate(Player* player) override
+    {
+        if (WorldSession* session = player->GetSession())
+            ChallengeAccountIndex::Instance().AddCharacter(session->GetAccountId());
+    }
+
+    void OnPlayerDelete(ObjectGuid guid, uint32 accountId) override
+    {
+        ChallengeAccountIndex::Instance().RemoveCharacter(accountId,
+            ChallengeManager::Instance().IsHardcoreGuid(guid.GetCounter()));
     }
 };
 
 class ChallengeSystemGuildHooks : public GuildScript
 {
 public:
-    ChallengeSystemGuildHooks() : GuildScript("ip_challengesystem_guild") {}
+    ChallengeSystemGuildHooks() : GuildScript("ip_challengesystem_guild", { GUILDHOOK_CAN_GUILD_SEND_BANK_LIST }) {}
 
     bool CanGuildSendBankList(Guild const* /*guild*/, WorldSession* session, uint8 /*tabId*/, bool /*sendAllSlots*/) override
     {
@@ -418,11 +434,10 @@ public:
             return true;
 
         Player* player = session->GetPlayer();
+        Trace(ChallengeTraceHook::GuildBank, player);
         if (!ChallengeManager::Instance().HandleGuildBankAccess(player))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.GuildBankBlocked",
-                    "Guild Bank access is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::GuildBankBlocked);
             return false;
         }
 
@@ -430,158 +445,148 @@ public:
     }
 };
 
-class ChallengeSystemPlayerbotBlocker : public ServerScript
+// NO_MOUNTS: fail mount casts before they start so the mount never lands.
+class ChallengeSystemSpellHooks : public AllSpellScript
 {
 public:
-    ChallengeSystemPlayerbotBlocker() : ServerScript("ip_challengesystem_playerbot_blocker", { SERVERHOOK_CAN_PACKET_RECEIVE }) {}
+    ChallengeSystemSpellHooks() : AllSpellScript("ip_challengesystem_spell", { ALLSPELLHOOK_ON_SPELL_CHECK_CAST }) {}
 
-    bool CanPacketReceive(WorldSession* session, WorldPacket& packet) override
+    void OnSpellCheckCast(Spell* spell, bool /*strict*/, SpellCastResult& res) override
     {
-        if (!session || packet.GetOpcode() != CMSG_MESSAGECHAT)
-            return true;
-
-        Player* player = session->GetPlayer();
-        if (!player)
-            return true;
-
-        bool noBots = ChallengeManager::Instance().HasRestriction(player, "NO_BOTS");
-        bool soloOnly = ChallengeManager::Instance().HasRestriction(player, "SOLO_ONLY");
-        bool hardcoreBlocked = sConfigMgr->GetOption<bool>("ChallengeSystem.Hardcore.BlockPlayerBots", true) &&
-                               ChallengeManager::Instance().HasRestriction(player, "HC_MANUAL_GROUP_ONLY_WITH_HC_TIER");
-        bool blockAllBots = noBots || soloOnly;
+        if (res != SPELL_CAST_OK)
+            return;
 
-        if (!blockAllBots && !hardcoreBlocked)
-            return true;
+        if (!ChallengeSpellTable::Current().Has(spell->GetSpellInfo()->Id, ChallengeSpellClass::Mount))
+            return;
 
-        WorldPacket data(packet);
-        uint32 type = 0;
-        uint32 lang = 0;
-        data >> type;
-        data >> lang;
+        Unit* caster = spell->GetCaster();
+        Player* player = caster ? caster->ToPlayer() : nullptr;
+        Trace(ChallengeTraceHook::MountCast, player, spell->GetSpellInfo()->Id);
+        if (!player || ChallengeManager::Instance().HandleMountCast(player))
+            return;
 
-        std::string msg;
-        if (!ExtractChatMessage(data, type, lang, msg))
-            return true;
+        res = SPELL_FAILED_DONT_REPORT;
+        SendPlayerError(player, ChallengeMessage::MountBlocked);
+    }
+};
 
-        if (msg.empty())
-            return true;
+class ChallengeSystemUnitHooks : public UnitScript
+{
+public:
+    explicit ChallengeSystemUnitHooks(ChallengeConfig const& config)
+        : UnitScript("ip_challengesystem_unit", true, GetHooks(config)) {}
 
-        char prefix = msg.front();
-        if (prefix != '.' && prefix != '!')
-            return true;
+    static std::vector<uint16> GetHooks(ChallengeConfig const& config)
+    {
+        std::vector<uint16> hooks = { UNITHOOK_ON_AURA_APPLY };
 
-        std::string command = msg.substr(1);
-        auto tokens = SplitWhitespace(command);
-        if (tokens.empty())
-            return true;
+        // Removal only matters for DEV test auras.
+        if (config.hasTestAuras)
+            hooks.push_back(UNITHOOK_ON_AURA_REMOVE);
 
-        if (ToLower(tokens[0]) != "playerbots")
-            return true;
+        return hooks;
+    }
 
-        if (tokens.size() < 2)
-            return true;
+    void OnAuraApply(Unit* unit, Aura* aura) override
+    {
+        if (Player* player = unit->ToPlayer())
+        {
+            Trace(ChallengeTraceHook::AuraApply, player, aura->GetId());
+            ChallengeManager::Instance().HandleAuraApply(player, aura);
+        }
+    }
 
-        std::string sub = ToLower(tokens[1]);
-        if (sub == "rndbot")
+    void OnAuraRemove(Unit* unit, AuraApplication* aurApp, AuraRemoveMode /*mode*/) override
+    {
+        if (Player* player = unit->ToPlayer())
         {
-            SendPlayerError(player,
-                GetConfigMessage(blockAllBots ? "ChallengeSystem.Message.BotsBlocked" : "ChallengeSystem.Message.RndBotsBlocked",
-                    blockAllBots ? "Player bots are disabled by active Challenge restrictions."
-                                 : "Random bot summoning is disabled by active Challenge restrictions."));
-            return false;
+            Trace(ChallengeTraceHook::AuraRemove, player, aurApp->GetBase()->GetId());
+            ChallengeManager::Instance().HandleAuraRemove(player, aurApp->GetBase());
         }
+    }
+};
 
-        if (sub != "bot")
-            return true;
+// Membership changes keep the group summary current and invalidate the cached group validity of every member.
+class ChallengeSystemGroupHooks : public GroupScript
+{
+public:
+    ChallengeSystemGroupHooks() : GroupScript("ip_challengesystem_group",
+        { GROUPHOOK_ON_CREATE, GROUPHOOK_ON_ADD_MEMBER, GROUPHOOK_ON_REMOVE_MEMBER, GROUPHOOK_ON_CHANGE_LEADER, GROUPHOOK_ON_DISBAND }) {}
 
-        if (tokens.size() < 3)
-            return true;
+    void OnCreate(Group* group, Player* leader) override
+    {
+        ChallengeManager::Instance().SeedGroupSummary(group);
+        if (leader)
+            TraceGroup(ChallengeTraceHook::GroupCreate, leader->GetGUID().GetCounter(), group);
+    }
 
-        std::string botCmd = ToLower(tokens[2]);
-        if (botCmd != "add" && botCmd != "addaccount" && botCmd != "login" && botCmd != "addclass")
-            return true;
+    void OnAddMember(Group* group, ObjectGuid guid) override
+    {
+        ChallengeManager::Instance().HandleGroupMemberAdded(group, guid.GetCounter());
+        TraceGroup(ChallengeTraceHook::GroupAddMember, guid.GetCounter(), group);
+    }
 
-        if (botCmd == "addclass")
-        {
-            if (blockAllBots)
-            {
-                SendPlayerError(player,
-                    GetConfigMessage("ChallengeSystem.Message.BotsBlocked",
-                        "Player bots are disabled by active Challenge restrictions."));
-                return false;
-            }
-
-            if (hardcoreBlocked)
-            {
-                SendPlayerError(player,
-                    GetConfigMessage("ChallengeSystem.Message.RndBotsBlocked",
-                        "Random bot summoning is disabled by active Challenge restrictions."));
-                return false;
-            }
+    void OnRemoveMember(Group* group, ObjectGuid guid, RemoveMethod /*method*/, ObjectGuid /*kicker*/, char const* /*reason*/) override
+    {
+        if (group->GetGUID().IsEmpty())
+            return;
 
-            return true;
-        }
+        ChallengeGroupIndex::Instance().RemoveMember(group->GetGUID().GetCounter(), guid.GetCounter());
+        TraceGroup(ChallengeTraceHook::GroupRemoveMember, guid.GetCounter(), group);
+    }
 
-        if (blockAllBots)
-        {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.BotsBlocked",
-                    "Player bots are disabled by active Challenge restrictions."));
-            return false;
-        }
+    void OnChangeLeader(Group* group, ObjectGuid newLeaderGuid, ObjectGuid /*oldLeaderGuid*/) override
+    {
+        if (group->GetGUID().IsEmpty())
+            return;
 
-        if (!hardcoreBlocked)
-            return true;
+        ChallengeGroupIndex::Instance().Touch(group->GetGUID().GetCounter());
+        TraceGroup(ChallengeTraceHook::GroupChangeLeader, newLeaderGuid.GetCounter(), group);
+    }
 
-        if (tokens.size() < 4)
-        {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.BotsRequireHardcore",
-                    "Only Hardcore characters may be summoned as bots."));
-            return false;
-        }
+    void OnDisband(Group* group) override
+    {
+        if (group->GetGUID().IsEmpty())
+            return;
 
-        std::string target = tokens[3];
-        if (target == "*" || target == "!")
-        {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.BotsRequireHardcore",
-                    "Only Hardcore characters may be summoned as bots."));
-            return false;
-        }
+        ChallengeGroupIndex::Instance().Erase(group->GetGUID().GetCounter());
+        TraceGroup(ChallengeTraceHook::GroupDisband, 0, group);
+    }
 
-        if (botCmd == "addaccount")
-        {
-            if (!AreAccountBotsHardcore(target))
-            {
-                SendPlayerError(player,
-                    GetConfigMessage("ChallengeSystem.Message.BotsRequireHardcore",
-                        "Only Hardcore characters may be summoned as bots."));
-                return false;
-            }
+private:
+    static void TraceGroup(ChallengeTraceHook hook, uint32 guid, Group const* group)
+    {
+        ChallengeTraceRecorder& recorder = ChallengeTraceRecorder::Instance();
+        if (recorder.IsRecording() && !group->GetGUID().IsEmpty())
+            recorder.Record(hook, guid, group->GetGUID().GetCounter());
+    }
+};
 
-            return true;
-        }
+/**
+ * Filters playerbot recruitment commands. Runs on the command dispatcher, so
+ * only `.`/`!` chat lines that reach command parsing are ever inspected and
+ * the text arrives as a view without touching the packet. Whispered bot
+ * control is filtered by the OnPlayerCanUseChat hooks instead.
+ */
+class ChallengeSystemPlayerbotBlocker : public AllCommandScript
+{
+public:
+    ChallengeSystemPlayerbotBlocker() : AllCommandScript("ip_challengesystem_playerbot_blocker", { ALLCOMMANDHOOK_ON_TRY_EXECUTE_COMMAND }) {}
 
-        for (std::string const& name : SplitComma(target))
-        {
-            if (!IsHardcoreBotAllowed(player, name))
-            {
-                SendPlayerError(player,
-                    GetConfigMessage("ChallengeSystem.Message.BotsRequireHardcore",
-                        "Only Hardcore characters may be summoned as bots."));
-                return false;
-            }
-        }
+    bool OnTryExecuteCommand(ChatHandler& handler, std::string_view cmdStr) override
+    {
+        WorldSession* session = handler.GetSession();
+        if (!session)
+            return true;
 
-        return true;
+        return ChallengeManager::Instance().HandleBotCommand(session->GetPlayer(), cmdStr);
     }
 };
 
 class ChallengeSystemMiscHooks : public MiscScript
 {
 public:
-    ChallengeSystemMiscHooks() : MiscScript("ip_challengesystem_misc") {}
+    ChallengeSystemMiscHooks() : MiscScript("ip_challengesystem_misc", { MISCHOOK_CAN_SEND_AUCTIONHELLO }) {}
 
     bool CanSendAuctionHello(WorldSession const* session, ObjectGuid /*guid*/, Creature* /*creature*/) override
     {
@@ -589,11 +594,10 @@ public:
             return true;
 
         Player* player = session->GetPlayer();
+        Trace(ChallengeTraceHook::Auction, player);
         if (!ChallengeManager::Instance().HandleAuctionAction(player))
         {
-            SendPlayerError(player,
-                GetConfigMessage("ChallengeSystem.Message.AuctionBlocked",
-                    "Auction House access is disabled by active Challenge restrictions."));
+            SendPlayerError(player, ChallengeMessage::AuctionBlocked);
             return false;
         }
 
@@ -601,36 +605,31 @@ public:
     }
 };
 
-class ChallengeSystemMailHooks : public MailScript
+void AddChallengeSystemScripts()
 {
-public:
-    ChallengeSystemMailHooks() : MailScript("ip_challengesystem_mail") {}
+    // Module config is loaded before scripts are added. Hook lists are fixed at
+    // registration, so only the hooks the configured features use are subscribed;
+    // switching a feature on with `.reload config` takes a restart.
+    ChallengeConfig::Reload();
+    ChallengeConfig const& config = ChallengeConfig::Current();
 
-    void OnBeforeMailDraftSendMailTo(MailDraft* /*mailDraft*/, MailReceiver const& receiver, MailSender const& /*sender*/,
-                                     MailCheckMask& /*checked*/, uint32& /*deliver_delay*/, uint32& /*custom_expiration*/,
-                                     bool& deleteMailItemsFromDB, bool& sendMail) override
-    {
-        Player* receiverPlayer = receiver.GetPlayer();
-        if (!receiverPlayer)
-            return;
+    new ChallengeSystemWorldHooks();
+    AddChallengeSystemCommands();
+    AddChallengeSystemRestrictions();
 
-        if (!ChallengeManager::Instance().HandleMailSend(receiverPlayer))
-        {
-            SendPlayerError(receiverPlayer,
-                GetConfigMessage("ChallengeSystem.Message.MailBlocked",
-                    "Mail is disabled by active Challenge restrictions."));
-            sendMail = false;
-            deleteMailItemsFromDB = false;
-        }
-    }
-};
+    if (!config.enabled)
+        return;
 
-void AddChallengeSystemScripts()
-{
-    new ChallengeSystemHooks();
+    new ChallengeSystemPlayerHooks();
+    new ChallengeSystemRestrictionHooks(config);
+    new ChallengeSystemPlayerbotHooks(config);
     new ChallengeSystemMiscHooks();
-    new ChallengeSystemMailHooks();
     new ChallengeSystemGuildHooks();
+    new ChallengeSystemGroupHooks();
+    new ChallengeSystemUnitHooks(config);
+    new ChallengeSystemSpellHooks();
     new ChallengeSystemPlayerbotBlocker();
-    AddChallengeSystemCommands();
+
+    if (config.permadeathEnabled)
+        new ChallengeSystemPermadeathHooks();
 }
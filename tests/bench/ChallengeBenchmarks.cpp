@@ -0,0 +1,379 @@
+#include "ChallengeConfig.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengeManager.h"
+#include "ChallengeSpellTable.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTimerWheel.h"
+#include "CharacterCache.h"
+#include "Config.h"
+#include "GameTime.h"
+#include "Group.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "SharedDefines.h"
+#include "SpellMgr.h"
+
+#include <benchmark/benchmark.h>
+
+#include <iterator>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+void AddChallengeSystemRestrictions();
+
+// The module's hook entry points on ChallengeManager, called with the
+// stand-in Player, Group, WorldSession and aura objects from stubs/ and the
+// built-in config. Characters are published to ChallengeStateIndex first, so
+// their first hook loads state the way a login does; group membership
+// changes are followed by what the module's GroupScript hooks would do.
+//
+//   challenge_bench --benchmark_format=json
+
+namespace
+{
+constexpr uint32 kTickMs = ChallengeTimerWheel::kResolutionMs;
+constexpr uint32 kAurasPerMember = 24;    // auras a NoBuffs sweep walks per character
+constexpr uint32 kChurnTicks = 50;        // one member leaves and rejoins every 5 s
+constexpr uint32 kSpellStoreSize = 80000; // about the size of a 3.3.5 spell store
+
+enum class Composition : uint8
+{
+    Casual = 0, // no Hardcore members: valid
+    Hardcore,   // Hardcore of one tier: valid
+    Mixed       // Hardcore with one casual member: invalid, runs group grace
+};
+
+// Fills the stand-in spell store (gaps, mostly positive spells, some passives
+// and mounts), loads the built-in config with a short NoBuffs allow list,
+// builds the spell table and registers the restrictions. Runs once.
+void SetUpModule()
+{
+    static bool const done = []()
+    {
+        std::vector<std::unique_ptr<SpellInfo>>& store = sSpellMgr->store;
+        store.resize(kSpellStoreSize);
+        for (uint32 spellId = 1; spellId < kSpellStoreSize; ++spellId)
+        {
+            if (spellId % 7 == 0)
+                continue;
+
+            AuraType aura = spellId % 97 == 0 ? SPELL_AURA_MOUNTED : SPELL_AURA_NONE;
+            store[spellId] = std::make_unique<SpellInfo>(spellId, spellId % 3 != 0, spellId % 5 == 0, aura);
+        }
+
+        sConfigMgr->SetOption("ChallengeSystem.NoBuffs.AllowSpells", "1126,1243,21562,25898,48470");
+        ChallengeConfig::Reload();
+        ChallengeSpellTable::Build(ChallengeConfig::Current());
+        AddChallengeSystemRestrictions();
+        return true;
+    }();
+
+    (void)done;
+}
+
+uint32 NextGuid()
+{
+    static uint32 next = 1000;
+    return ++next;
+}
+
+// A logged-in character: session, player and published challenge state.
+struct StandInCharacter
+{
+    StandInCharacter(uint8 tier, uint32 flags, bool bot = false)
+        : session(NextGuid(), bot), player(session.GetAccountId(), &session)
+    {
+        ChallengeStateIndex::Instance().Publish(player.GetGUID().GetCounter(), tier, flags);
+        ObjectAccessor::AddObject(&player);
+    }
+
+    ~StandInCharacter()
+    {
+        ChallengeTimerWheel::Instance().CancelAll(player.GetGUID().GetCounter());
+        ObjectAccessor::RemoveObject(&player);
+    }
+
+    WorldSession session;
+    Player player;
+};
+
+// A saved group of size stand-in characters, seeded like GroupScript::OnCreate.
+struct StandInGroup
+{
+    StandInGroup(uint32 size, Composition composition, uint32 extraFlags) : group(NextGuid())
+    {
+        constexpr uint32 kHardcoreFlags = ChallengeManager::FLAG_HARDCORE | ChallengeManager::FLAG_PERMADEATH;
+        for (uint32 i = 0; i < size; ++i)
+        {
+            uint32 flags = extraFlags;
+            if (composition == Composition::Hardcore || (composition == Composition::Mixed && i + 1 < size))
+                flags |= kHardcoreFlags;
+
+            members.push_back(std::make_unique<StandInCharacter>(1, flags));
+            group.AddMember(&members.back()->player);
+        }
+
+        ChallengeManager::Instance().SeedGroupSummary(&group);
+    }
+
+    // Leave and rejoin, with the index updates the module's group hooks make.
+    void Rejoin(Player* player)
+    {
+        uint32 guid = player->GetGUID().GetCounter();
+        if (player->GetGroup())
+            player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
+        ChallengeGroupIndex::Instance().RemoveMember(group.GetGUID().GetCounter(), guid);
+
+        group.AddMember(player);
+        ChallengeManager::Instance().HandleGroupMemberAdded(&group, guid);
+    }
+
+    Group group; // declared first so the members leave it before it goes
+    std::vector<std::unique_ptr<StandInCharacter>> members;
+};
+
+// Spell ids spread over the store, as a stream of aura applications.
+uint32 NextSpell(uint32& cursor)
+{
+    cursor = (cursor + 7919) % kSpellStoreSize;
+    return cursor;
+}
+
+// Buffs a NoBuffs character may keep (passive, negative or allow-listed), so
+// sweeps walk them without removing any.
+void ApplyAllowedAuras(Player& player, uint32& cursor)
+{
+    ChallengeSpellTable const& spells = ChallengeSpellTable::Current();
+    for (uint32 applied = 0; applied < kAurasPerMember;)
+    {
+        uint32 spellId = NextSpell(cursor);
+        if (!sSpellMgr->GetSpellInfo(spellId) || spells.IsForbiddenBuff(spellId))
+            continue;
+
+        player.AddAura(spellId, &player);
+        ++applied;
+    }
+}
+
+void GroupSizes(benchmark::internal::Benchmark* bench)
+{
+    for (int64 size : { 5, 25, 40 })
+        for (int64 composition : { 0, 1, 2 })
+            bench->Args({ size, composition });
+}
+
+void PlayerUpdateCases(benchmark::internal::Benchmark* bench)
+{
+    for (int64 size : { 5, 25, 40 })
+        for (int64 noBuffs : { 0, 1 })
+            for (int64 grace : { 0, 1 })
+                bench->Args({ size, noBuffs, grace });
+}
+}
+
+// Restriction query every hook starts with, over all restriction ids.
+static void BM_HasRestriction(benchmark::State& state)
+{
+    SetUpModule();
+    StandInCharacter character(1, ChallengeManager::FLAG_HARDCORE | ChallengeManager::FLAG_NO_TRADE);
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    uint32 next = 0;
+    uint32 sink = 0;
+    for (auto _ : state)
+    {
+        sink += manager.HasRestriction(&character.player, static_cast<RestrictionId>(next++ % static_cast<uint32>(RestrictionId::Count)));
+        benchmark::DoNotOptimize(sink);
+    }
+}
+BENCHMARK(BM_HasRestriction);
+
+// One 100 ms world tick for every member of a group: HandlePlayerUpdate for
+// each, then UpdateTimers. A member leaves and rejoins every kChurnTicks, so
+// cached group validity is re-evaluated; with NoBuffs the sweep timer walks
+// each member's auras, and a mixed group runs group grace and warnings until
+// its members are removed (they rejoin at once).
+static void BM_PlayerUpdate(benchmark::State& state)
+{
+    SetUpModule();
+    uint32 size = static_cast<uint32>(state.range(0));
+    bool noBuffs = state.range(1) != 0;
+    bool grace = state.range(2) != 0;
+
+    StandInGroup party(size, grace ? Composition::Mixed : Composition::Hardcore,
+        noBuffs ? ChallengeManager::FLAG_NO_BUFFS : 0);
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    uint32 cursor = 0;
+    for (auto const& member : party.members)
+        ApplyAllowedAuras(member->player, cursor);
+
+    Seconds const start = GameTime::GetGameTime();
+    uint64 elapsedMs = 0;
+    uint32 ticks = 0;
+    for (auto _ : state)
+    {
+        elapsedMs += kTickMs;
+        GameTime::SetGameTime(start + Seconds(elapsedMs / IN_MILLISECONDS));
+
+        if (++ticks % kChurnTicks == 0)
+            party.Rejoin(&party.members.back()->player);
+
+        for (auto const& member : party.members)
+            manager.HandlePlayerUpdate(&member->player, kTickMs);
+
+        manager.UpdateTimers(kTickMs);
+
+        for (auto const& member : party.members)
+        {
+            if (!member->player.GetGroup())
+                party.Rejoin(&member->player);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_PlayerUpdate)->ArgNames({ "members", "nobuffs", "grace" })->Apply(PlayerUpdateCases);
+
+// Accept check for each member in turn, as on an invite accept and on every
+// re-evaluation of cached group validity.
+static void BM_GroupAccept(benchmark::State& state)
+{
+    SetUpModule();
+    uint32 size = static_cast<uint32>(state.range(0));
+    StandInGroup party(size, static_cast<Composition>(state.range(1)), 0);
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    uint32 next = 0;
+    uint32 accepted = 0;
+    for (auto _ : state)
+    {
+        accepted += manager.HandleGroupAccept(&party.members[next++ % size]->player, &party.group);
+        benchmark::DoNotOptimize(accepted);
+    }
+}
+BENCHMARK(BM_GroupAccept)->ArgNames({ "members", "composition" })->Apply(GroupSizes);
+
+// XP adjustment for kill and quest XP: no XP restriction, HALF_XP, ONLY_QUEST_XP.
+static void BM_GiveXP(benchmark::State& state)
+{
+    SetUpModule();
+    uint32 const flags[] = { 0, ChallengeManager::FLAG_HALF_XP, ChallengeManager::FLAG_ONLY_QUEST_XP };
+    StandInCharacter character(1, flags[state.range(0)]);
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    uint32 next = 0;
+    uint32 sink = 0;
+    for (auto _ : state)
+    {
+        uint32 amount = 250;
+        manager.HandleGiveXP(&character.player, amount, next++ % 2 ? XPSOURCE_QUEST : XPSOURCE_KILL);
+        sink += amount;
+        benchmark::DoNotOptimize(sink);
+    }
+}
+BENCHMARK(BM_GiveXP)->ArgName("restriction")->DenseRange(0, 2);
+
+// Party chat through the playerbot filter, from a casual or a Hardcore
+// sender in a party with a casual playerbot.
+static void BM_BotChat(benchmark::State& state)
+{
+    SetUpModule();
+    bool hardcore = state.range(0) != 0;
+    StandInGroup party(4, hardcore ? Composition::Hardcore : Composition::Casual, 0);
+    StandInCharacter bot(1, 0, true);
+    party.Rejoin(&bot.player);
+    Player* sender = &party.members.front()->player;
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    std::string_view const lines[] = { "attack", "hello there, anyone up for a dungeon?", "follow",
+        "  Tank   Attack", "lfm ramparts, need heals" };
+
+    uint32 next = 0;
+    uint32 sink = 0;
+    for (auto _ : state)
+    {
+        sink += manager.HandleBotChat(sender, LANG_UNIVERSAL, lines[next++ % std::size(lines)], nullptr, &party.group);
+        benchmark::DoNotOptimize(sink);
+    }
+}
+BENCHMARK(BM_BotChat)->ArgName("hardcore")->DenseRange(0, 1);
+
+// `.playerbots` recruitment commands from a Hardcore character, naming
+// Hardcore and casual characters.
+static void BM_BotCommand(benchmark::State& state)
+{
+    SetUpModule();
+    StandInCharacter master(1, ChallengeManager::FLAG_HARDCORE);
+    StandInCharacter alice(1, ChallengeManager::FLAG_HARDCORE);
+    StandInCharacter bob(0, 0);
+    sCharacterCache->AddCharacterCacheEntry(alice.player.GetGUID(), alice.session.GetAccountId(), "Alice");
+    sCharacterCache->AddCharacterCacheEntry(bob.player.GetGUID(), bob.session.GetAccountId(), "Bob");
+    ChallengeManager& manager = ChallengeManager::Instance();
+
+    std::string_view const commands[] = { "playerbots bot add Alice", "playerbots bot add Alice,Bob",
+        "playerbots rndbot", "gps", "playerbots bot login Alice" };
+
+    uint32 next = 0;
+    uint32 sink = 0;
+    for (auto _ : state)
+    {
+        sink += manager.HandleBotCommand(&master.player, commands[next++ % std::size(commands)]);
+        benchmark::DoNotOptimize(sink);
+    }
+}
+BENCHMARK(BM_BotCommand);
+
+// Offline lookup (mail receivers, group members) over a realm-sized population.
+static void BM_StateIndexFind(benchmark::State& state)
+{
+    constexpr uint32 kPopulation = 50000;
+    constexpr uint32 kGuidBase = 2000000;
+    ChallengeStateIndex& states = ChallengeStateIndex::Instance();
+    for (uint32 i = 0; i < kPopulation; ++i)
+        states.Publish(kGuidBase + i, 1 + i % 3, ChallengeManager::FLAG_HARDCORE);
+
+    uint32 next = 0;
+    uint32 found = 0;
+    for (auto _ : state)
+    {
+        ChallengeStateIndex::Entry entry;
+        // Half the lookups miss, like characters without a tier.
+        found += states.Find(kGuidBase + (next++ * 7919) % (kPopulation * 2), entry);
+        benchmark::DoNotOptimize(found);
+    }
+}
+BENCHMARK(BM_StateIndexFind);
+
+// Aura-apply check under NoBuffs.
+static void BM_SpellTableHas(benchmark::State& state)
+{
+    SetUpModule();
+    ChallengeSpellTable const& spells = ChallengeSpellTable::Current();
+
+    uint32 cursor = 0;
+    uint32 sink = 0;
+    for (auto _ : state)
+    {
+        sink += spells.IsForbiddenBuff(NextSpell(cursor));
+        benchmark::DoNotOptimize(sink);
+    }
+}
+BENCHMARK(BM_SpellTableHas);
+
+// Grace entered and left again before it expires.
+static void BM_TimerWheelScheduleCancel(benchmark::State& state)
+{
+    constexpr uint32 kGuid = 3000000;
+    uint32 graceMs = ChallengeConfig::Current().groupGracePeriodSeconds * IN_MILLISECONDS;
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    for (auto _ : state)
+    {
+        wheel.Schedule(kGuid, ChallengeTimer::GroupGrace, graceMs);
+        wheel.Cancel(kGuid, ChallengeTimer::GroupGrace);
+    }
+}
+BENCHMARK(BM_TimerWheelScheduleCancel);
+
+BENCHMARK_MAIN();
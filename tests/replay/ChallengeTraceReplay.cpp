@@ -0,0 +1,315 @@
+#include "ChallengeTraceReplay.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengeManager.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTimerWheel.h"
+#include "Common.h"
+#include "Config.h"
+#include "GameTime.h"
+#include "Item.h"
+#include "ObjectAccessor.h"
+#include "SharedDefines.h"
+#include "SpellAuras.h"
+
+#include <chrono>
+
+namespace
+{
+constexpr char const* kPlainChatLine = "anyone up for a dungeon?";
+
+// The first configured combat command, so combat lines classify as they did when recorded.
+std::string GetCombatChatLine()
+{
+    std::string commands = sConfigMgr->GetOption<std::string>("ChallengeSystem.Playerbots.CombatCommands", "attack", false);
+    return commands.substr(0, commands.find(','));
+}
+}
+
+ChallengeTraceReplay::ChallengeTraceReplay() : _startTime(GameTime::GetGameTime())
+{
+}
+
+ChallengeTraceReplay::~ChallengeTraceReplay()
+{
+    for (auto const& [groupGuid, group] : _groups)
+    {
+        if (groupGuid)
+            ChallengeGroupIndex::Instance().Erase(groupGuid);
+    }
+
+    for (auto const& [guid, character] : _characters)
+    {
+        ChallengeTimerWheel::Instance().CancelAll(guid);
+        ObjectAccessor::RemoveObject(&character->player);
+    }
+}
+
+ChallengeTraceReplay::Result ChallengeTraceReplay::Run(std::vector<ChallengeTraceRecord> const& records)
+{
+    Result result;
+    result.records = static_cast<uint32>(records.size());
+    if (records.empty())
+        return result;
+
+    result.traceMs = records.back().timeMs - records.front().timeMs;
+
+    // Bot sessions are fixed when the character is created, so find the bots first.
+    for (ChallengeTraceRecord const& record : records)
+    {
+        if (record.hook == ChallengeTraceHook::BotChat && record.arg1)
+            _bots.insert(record.arg1);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (ChallengeTraceRecord const& record : records)
+    {
+        AdvanceTo(record.timeMs);
+
+        size_t index = static_cast<size_t>(record.hook);
+        ++result.counts[index];
+        if (!Replay(record))
+            ++result.refused[index];
+    }
+
+    result.elapsedNs = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    result.characters = static_cast<uint32>(_characters.size());
+    return result;
+}
+
+Player* ChallengeTraceReplay::FindPlayer(uint32 guid) const
+{
+    auto itr = _characters.find(guid);
+    return itr != _characters.end() ? &itr->second->player : nullptr;
+}
+
+bool ChallengeTraceReplay::Replay(ChallengeTraceRecord const& record)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    uint32 guid = record.guid;
+    switch (record.hook)
+    {
+        case ChallengeTraceHook::Login:
+        {
+            Player* player = GetPlayer(guid);
+            _characters[guid]->online = true;
+            ObjectAccessor::AddObject(player);
+            manager.HandlePlayerLogin(player);
+            return true;
+        }
+        case ChallengeTraceHook::Logout:
+        {
+            Player* player = GetPlayer(guid);
+            manager.HandlePlayerLogout(player);
+            ObjectAccessor::RemoveObject(player);
+            _characters[guid]->online = false;
+            return true;
+        }
+        case ChallengeTraceHook::StateChanged:
+            ChangeState(guid, static_cast<uint8>(record.arg0), record.arg1);
+            return true;
+        case ChallengeTraceHook::Update:
+            manager.HandlePlayerUpdate(GetPlayer(guid), record.arg0);
+            return true;
+        case ChallengeTraceHook::GroupInvite:
+            return manager.HandleGroupInvite(GetPlayer(guid), GetOnlinePlayer(record.arg0));
+        case ChallengeTraceHook::GroupAccept:
+        {
+            // A group still being formed has no guid and no summary yet.
+            Group forming;
+            Group* group = record.arg0 ? GetGroup(record.arg0) : &forming;
+            if (record.arg1 && !group->isLFGGroup())
+                group->ConvertToLFG();
+            return manager.HandleGroupAccept(GetPlayer(guid), group);
+        }
+        case ChallengeTraceHook::Trade:
+            return manager.HandleTradeAttempt(GetPlayer(guid), GetOnlinePlayer(record.arg0));
+        case ChallengeTraceHook::MailSend:
+            return manager.HandleMailSend(GetPlayer(guid));
+        case ChallengeTraceHook::MailReceive:
+            return manager.HandleMailReceive(guid);
+        case ChallengeTraceHook::Auction:
+            return manager.HandleAuctionAction(GetPlayer(guid));
+        case ChallengeTraceHook::EquipItem:
+        {
+            Player* player = GetPlayer(guid);
+            ItemTemplate proto;
+            proto.ItemId = record.arg0;
+            proto.Quality = record.GetEquipQuality();
+            Item item(0, &proto, record.IsEquipSelfCrafted() ? player->GetGUID() : ObjectGuid());
+            return manager.HandleEquipItem(player, &item, static_cast<uint8>(record.arg1 & 0xFF), false);
+        }
+        case ChallengeTraceHook::MoneyChanged:
+        {
+            Player* player = GetPlayer(guid);
+            player->SetMoney(record.arg1);
+            int32 amount = static_cast<int32>(record.arg0);
+            manager.HandleMoneyChange(player, amount);
+            return amount == static_cast<int32>(record.arg0);
+        }
+        case ChallengeTraceHook::TalentPoints:
+        {
+            uint32 points = record.arg0;
+            manager.HandleTalentPoints(GetPlayer(guid), points);
+            return points == record.arg0;
+        }
+        case ChallengeTraceHook::GiveXP:
+        {
+            uint32 amount = record.arg0;
+            manager.HandleGiveXP(GetPlayer(guid), amount, static_cast<uint8>(record.arg1));
+            return amount == record.arg0;
+        }
+        case ChallengeTraceHook::QuestXP:
+        {
+            uint32 xp = record.arg0;
+            manager.HandleQuestXP(GetPlayer(guid), xp);
+            return xp == record.arg0;
+        }
+        case ChallengeTraceHook::Summon:
+            return manager.HandleSummonAccept(GetPlayer(guid), GetOnlinePlayer(record.arg0), 0);
+        case ChallengeTraceHook::Death:
+            // Arena, battleground and duel deaths were resolved live; the stand-in is never in one.
+            manager.HandleDeath(GetPlayer(guid));
+            return true;
+        case ChallengeTraceHook::GuildBank:
+            return manager.HandleGuildBankAccess(GetPlayer(guid));
+        case ChallengeTraceHook::MountCast:
+            return manager.HandleMountCast(GetPlayer(guid));
+        case ChallengeTraceHook::AuraApply:
+        {
+            // A forbidden buff is removed on the owner's next Update.
+            Player* player = GetPlayer(guid);
+            manager.HandleAuraApply(player, player->AddAura(record.arg0, player));
+            return true;
+        }
+        case ChallengeTraceHook::AuraRemove:
+        {
+            Player* player = GetPlayer(guid);
+            Aura aura(record.arg0);
+            player->RemoveAura(record.arg0);
+            manager.HandleAuraRemove(player, &aura);
+            return true;
+        }
+        case ChallengeTraceHook::BotChat:
+        {
+            static std::string const combatLine = GetCombatChatLine();
+            Player* player = GetPlayer(guid);
+            Player* bot = record.arg1 ? GetPlayer(record.arg1) : nullptr;
+            return manager.HandleBotChat(player, LANG_UNIVERSAL, record.arg0 ? combatLine : kPlainChatLine, bot,
+                player->GetGroup());
+        }
+        case ChallengeTraceHook::GroupCreate:
+            AddMember(guid, record.arg0);
+            return true;
+        case ChallengeTraceHook::GroupAddMember:
+            AddMember(guid, record.arg0);
+            return true;
+        case ChallengeTraceHook::GroupRemoveMember:
+            RemoveMember(guid, record.arg0);
+            return true;
+        case ChallengeTraceHook::GroupChangeLeader:
+            ChallengeGroupIndex::Instance().Touch(record.arg0);
+            return true;
+        case ChallengeTraceHook::GroupDisband:
+            Disband(record.arg0);
+            return true;
+        default:
+            return true;
+    }
+}
+
+void ChallengeTraceReplay::AdvanceTo(uint32 timeMs)
+{
+    if (timeMs <= _nowMs)
+        return;
+
+    uint32 diff = timeMs - _nowMs;
+    _nowMs = timeMs;
+    GameTime::SetGameTime(_startTime + Seconds(_nowMs / IN_MILLISECONDS));
+    ChallengeManager::Instance().UpdateTimers(diff);
+}
+
+Player* ChallengeTraceReplay::GetPlayer(uint32 guid)
+{
+    std::unique_ptr<Character>& character = _characters[guid];
+    if (!character)
+    {
+        character = std::make_unique<Character>(guid, _bots.count(guid) != 0);
+        ObjectAccessor::AddObject(&character->player);
+    }
+
+    return &character->player;
+}
+
+Player* ChallengeTraceReplay::GetOnlinePlayer(uint32 guid)
+{
+    if (!guid)
+        return nullptr;
+
+    Player* player = GetPlayer(guid);
+    return _characters[guid]->online ? player : nullptr;
+}
+
+Group* ChallengeTraceReplay::GetGroup(uint32 groupGuid)
+{
+    std::unique_ptr<Group>& group = _groups[groupGuid];
+    if (!group)
+        group = std::make_unique<Group>(groupGuid);
+
+    return group.get();
+}
+
+// Online characters change state through the manager, as `.ipchallenge set` does.
+// The rest (the trace's opening records, logouts) only reach the state index,
+// as the rows loaded at startup do.
+void ChallengeTraceReplay::ChangeState(uint32 guid, uint8 tier, uint32 flags)
+{
+    auto itr = _characters.find(guid);
+    if (itr == _characters.end() || !itr->second->online)
+    {
+        ChallengeStateIndex::Instance().Publish(guid, tier, flags);
+        return;
+    }
+
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Player* player = &itr->second->player;
+    if (manager.GetActiveTier(player) != tier || manager.GetActiveFlags(player) != flags)
+        manager.SetActiveTierFlags(player, tier, flags);
+}
+
+// Groups the trace first meets here (created, or formed before recording) are
+// seeded with this member, as GroupScript::OnCreate does.
+void ChallengeTraceReplay::AddMember(uint32 guid, uint32 groupGuid)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Player* player = GetPlayer(guid);
+    Group* group = GetGroup(groupGuid);
+    if (player->GetGroup() == group)
+        return;
+
+    if (player->GetGroup())
+        player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
+
+    bool created = group->GetMembersCount() == 0;
+    group->AddMember(player);
+    if (created)
+        manager.SeedGroupSummary(group);
+    else
+        manager.HandleGroupMemberAdded(group, guid);
+}
+
+// The member may already be gone: the replayed grace timer removes it before the recorded removal arrives.
+void ChallengeTraceReplay::RemoveMember(uint32 guid, uint32 groupGuid)
+{
+    Player* player = GetPlayer(guid);
+    if (player->GetGroup() && player->GetGroup()->GetGUID().GetCounter() == groupGuid)
+        player->RemoveFromGroup(GROUP_REMOVEMETHOD_LEAVE);
+
+    ChallengeGroupIndex::Instance().RemoveMember(groupGuid, guid);
+}
+
+void ChallengeTraceReplay::Disband(uint32 groupGuid)
+{
+    ChallengeGroupIndex::Instance().Erase(groupGuid);
+    _groups.erase(groupGuid);
+}
@@ -0,0 +1,90 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_REPLAY_H
+#define MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_REPLAY_H
+
+#include "ChallengeTrace.h"
+#include "Duration.h"
+#include "Group.h"
+#include "Player.h"
+
+#include <array>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * ChallengeTraceReplay
+ *
+ * Replays a recorded trace through ChallengeManager, as fast as possible,
+ * in the offline test build. Every recorded character gets a stand-in
+ * Player and WorldSession (from stubs/) and every recorded group a stand-in
+ * Group; each record calls the ChallengeManager entry point its hook calls
+ * on a live server, and group records do what the module's GroupScript
+ * hooks do. Game time and ChallengeManager::UpdateTimers follow the trace's
+ * clock, so grace, warning, NoBuffs and permadeath timers fire as recorded.
+ *
+ * What the trace carries no object for is rebuilt from the record's
+ * arguments: an item of the recorded quality and creator, the money before
+ * a change, a combat or plain chat line, a bot session for every character
+ * a bot chat record names.
+ *
+ * The replay uses the module's singletons (state and group indexes, timer
+ * wheel, ObjectAccessor), so run it in its own process (challenge_replay)
+ * or on guids nothing else uses. A replay object is used once.
+ */
+class ChallengeTraceReplay
+{
+public:
+    struct Result
+    {
+        uint32 records = 0;
+        uint32 characters = 0; // distinct guids replayed
+        uint64 elapsedNs = 0;
+        uint32 traceMs = 0;    // recorded wall time covered by the trace
+        std::array<uint32, static_cast<size_t>(ChallengeTraceHook::Count)> counts = {};
+        std::array<uint32, static_cast<size_t>(ChallengeTraceHook::Count)> refused = {}; // blocked or reduced
+    };
+
+    ChallengeTraceReplay();
+    ~ChallengeTraceReplay();
+
+    ChallengeTraceReplay(ChallengeTraceReplay const&) = delete;
+    ChallengeTraceReplay& operator=(ChallengeTraceReplay const&) = delete;
+
+    Result Run(std::vector<ChallengeTraceRecord> const& records);
+
+    // The stand-in for a replayed character, null if the trace never named it.
+    Player* FindPlayer(uint32 guid) const;
+
+private:
+    struct Character
+    {
+        Character(uint32 guid, bool bot) : session(guid, bot), player(guid, &session) {}
+
+        WorldSession session; // one account per character
+        Player player;
+        bool online = true;   // characters the trace meets before their login were online when it started
+    };
+
+    // Replays one record; false when the module refused or reduced it.
+    bool Replay(ChallengeTraceRecord const& record);
+    void AdvanceTo(uint32 timeMs);
+
+    Player* GetPlayer(uint32 guid);
+    Player* GetOnlinePlayer(uint32 guid); // null for guid 0 and characters logged out
+    Group* GetGroup(uint32 groupGuid);
+
+    void ChangeState(uint32 guid, uint8 tier, uint32 flags);
+    void AddMember(uint32 guid, uint32 groupGuid);
+    void RemoveMember(uint32 guid, uint32 groupGuid);
+    void Disband(uint32 groupGuid);
+
+    // Declared before _groups: a group clears its members' group on destruction.
+    std::unordered_map<uint32, std::unique_ptr<Character>> _characters;
+    std::unordered_map<uint32, std::unique_ptr<Group>> _groups;
+    std::unordered_set<uint32> _bots;
+    Seconds _startTime;
+    uint32 _nowMs = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_CHALLENGE_TRACE_REPLAY_H
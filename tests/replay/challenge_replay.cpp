@@ -0,0 +1,106 @@
+#include "ChallengeConfig.h"
+#include "ChallengeSpellTable.h"
+#include "ChallengeTrace.h"
+#include "ChallengeTraceReplay.h"
+#include "Config.h"
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+void AddChallengeSystemRestrictions();
+
+// Replays a trace recorded with `.ipchallenge trace` through ChallengeManager
+// and prints throughput and per-hook calls and refusals as JSON. Run it from
+// two builds on the same trace to compare them.
+//
+//   challenge_replay <trace> [mod-ip-challengesystem.conf] > replay.json
+//
+// Without a config file the module's built-in defaults apply. The spell store
+// is empty, so no aura counts as a mount or a forbidden buff.
+
+namespace
+{
+std::string_view Trim(std::string_view text)
+{
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == std::string_view::npos)
+        return {};
+
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+// Reads the `Key = Value` lines of a worldserver-style .conf into the stand-in ConfigMgr.
+bool LoadConfig(char const* path)
+{
+    std::ifstream file(path);
+    if (!file)
+        return false;
+
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::string_view text = Trim(line);
+        size_t equals = text.find('=');
+        if (text.empty() || text.front() == '#' || text.front() == '[' || equals == std::string_view::npos)
+            continue;
+
+        std::string_view value = Trim(text.substr(equals + 1));
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+
+        sConfigMgr->SetOption(std::string(Trim(text.substr(0, equals))), std::string(value));
+    }
+
+    return true;
+}
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::fprintf(stderr, "usage: %s <trace> [mod-ip-challengesystem.conf]\n", argv[0]);
+        return 2;
+    }
+
+    if (argc == 3 && !LoadConfig(argv[2]))
+    {
+        std::fprintf(stderr, "could not read config file '%s'\n", argv[2]);
+        return 1;
+    }
+
+    std::vector<ChallengeTraceRecord> records;
+    if (!ChallengeTraceRecorder::Load(argv[1], records))
+    {
+        std::fprintf(stderr, "could not read trace file '%s'\n", argv[1]);
+        return 1;
+    }
+
+    ChallengeConfig::Reload();
+    ChallengeSpellTable::Build(ChallengeConfig::Current());
+    AddChallengeSystemRestrictions();
+
+    ChallengeTraceReplay replay;
+    ChallengeTraceReplay::Result result = replay.Run(records);
+    double elapsedMs = result.elapsedNs / 1000000.0;
+    double perSecond = result.elapsedNs ? result.records * 1000000000.0 / result.elapsedNs : 0.0;
+
+    std::printf("{\"records\":%u,\"characters\":%u,\"trace_ms\":%u,\"elapsed_ms\":%.1f,\"hooks_per_sec\":%.1f,\"hooks\":{",
+        result.records, result.characters, result.traceMs, elapsedMs, perSecond);
+    bool first = true;
+    for (size_t i = 0; i < result.counts.size(); ++i)
+    {
+        if (!result.counts[i])
+            continue;
+
+        std::printf("%s\"%s\":{\"calls\":%u,\"refused\":%u}", first ? "" : ",",
+            ChallengeTraceRecorder::GetHookName(static_cast<ChallengeTraceHook>(i)), result.counts[i], result.refused[i]);
+        first = false;
+    }
+    std::printf("}}\n");
+    return 0;
+}
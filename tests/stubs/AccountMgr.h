@@ -0,0 +1,16 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_ACCOUNT_MGR_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_ACCOUNT_MGR_H
+
+// Stand-in for the core's AccountMgr.h. There are no account names, so a
+// name always resolves through the character cache instead.
+
+#include "Define.h"
+
+#include <string>
+
+namespace AccountMgr
+{
+inline uint32 GetId(std::string const& /*username*/) { return 0; }
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_ACCOUNT_MGR_H
@@ -0,0 +1,46 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHARACTER_CACHE_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHARACTER_CACHE_H
+
+// Stand-in for the core's CharacterCache.h: name, guid and account of the
+// characters the caller adds.
+
+#include "ObjectGuid.h"
+
+#include <string>
+#include <unordered_map>
+
+class CharacterCache
+{
+public:
+    static CharacterCache* instance()
+    {
+        static CharacterCache instance;
+        return &instance;
+    }
+
+    void AddCharacterCacheEntry(ObjectGuid const& guid, uint32 accountId, std::string const& name)
+    {
+        _guidsByName[name] = guid;
+        _accounts[guid.GetCounter()] = accountId;
+    }
+
+    ObjectGuid GetCharacterGuidByName(std::string const& name) const
+    {
+        auto itr = _guidsByName.find(name);
+        return itr != _guidsByName.end() ? itr->second : ObjectGuid();
+    }
+
+    uint32 GetCharacterAccountIdByGuid(ObjectGuid guid) const
+    {
+        auto itr = _accounts.find(guid.GetCounter());
+        return itr != _accounts.end() ? itr->second : 0;
+    }
+
+private:
+    std::unordered_map<std::string, ObjectGuid> _guidsByName;
+    std::unordered_map<uint32, uint32> _accounts;
+};
+
+#define sCharacterCache CharacterCache::instance()
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHARACTER_CACHE_H
@@ -0,0 +1,30 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHAT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHAT_H
+
+// Stand-in for the core's Chat.h: messages are recorded on the session.
+
+#include "WorldSession.h"
+
+#include <string_view>
+
+class ChatHandler
+{
+public:
+    explicit ChatHandler(WorldSession* session) : _session(session) {}
+
+    WorldSession* GetSession() { return _session; }
+
+    void SendSysMessage(std::string_view str) { Record(str); }
+    void SendNotification(std::string_view str) { Record(str); }
+
+private:
+    void Record(std::string_view str)
+    {
+        ++_session->messageCount;
+        _session->lastMessage.assign(str);
+    }
+
+    WorldSession* _session;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_CHAT_H
@@ -0,0 +1,16 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_COMMON_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_COMMON_H
+
+// Stand-in for the core's Common.h: only the time constants.
+
+#include "Define.h"
+
+enum TimeConstants
+{
+    MINUTE = 60,
+    HOUR = MINUTE * 60,
+    DAY = HOUR * 24,
+    IN_MILLISECONDS = 1000
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_COMMON_H
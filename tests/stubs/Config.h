@@ -0,0 +1,40 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_CONFIG_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_CONFIG_H
+
+// Stand-in for the core's Config.h. Options are set in code with SetOption;
+// anything unset or unparsable reads as the default.
+
+#include "StringConvert.h"
+
+#include <map>
+#include <string>
+
+class ConfigMgr
+{
+public:
+    static ConfigMgr* instance()
+    {
+        static ConfigMgr instance;
+        return &instance;
+    }
+
+    template<typename T>
+    T GetOption(std::string const& name, T const& def, bool /*showLogs*/ = true) const
+    {
+        auto itr = _options.find(name);
+        if (itr == _options.end())
+            return def;
+
+        return Acore::StringTo<T>(itr->second).value_or(def);
+    }
+
+    void SetOption(std::string const& name, std::string const& value) { _options[name] = value; }
+    void ClearOptions() { _options.clear(); }
+
+private:
+    std::map<std::string, std::string> _options;
+};
+
+#define sConfigMgr ConfigMgr::instance()
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_CONFIG_H
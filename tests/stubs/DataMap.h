@@ -0,0 +1,46 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATA_MAP_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATA_MAP_H
+
+// Stand-in for the core's DataMap.h, with the same lookup: a string-keyed
+// hash map and a dynamic_cast per Get.
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+class DataMap
+{
+public:
+    class Base
+    {
+    public:
+        virtual ~Base() = default;
+    };
+
+    template<class T>
+    T* Get(std::string const& k) const
+    {
+        auto it = Container.find(k);
+        if (it != Container.end())
+            return dynamic_cast<T*>(it->second.get());
+        return nullptr;
+    }
+
+    template<class T>
+    T* GetDefault(std::string const& k)
+    {
+        if (T* v = Get<T>(k))
+            return v;
+        T* v = new T();
+        Container.emplace(k, std::unique_ptr<T>(v));
+        return v;
+    }
+
+    void Set(std::string const& k, Base* v) { Container[k] = std::unique_ptr<Base>(v); }
+    void Erase(std::string const& k) { Container.erase(k); }
+
+private:
+    std::unordered_map<std::string, std::unique_ptr<Base>> Container;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATA_MAP_H
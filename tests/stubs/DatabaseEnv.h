@@ -0,0 +1,40 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_H
+
+// Stand-in for the core's DatabaseEnv.h. There is no database: queries
+// return no rows and writes are dropped.
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+#include "QueryResult.h"
+
+#include <string>
+#include <utility>
+
+class Transaction
+{
+public:
+    void Append(std::string const& /*sql*/) {}
+};
+
+class QueryCallback
+{
+public:
+    template<typename Fn>
+    QueryCallback&& WithCallback(Fn&& /*callback*/) { return std::move(*this); }
+};
+
+class CharacterDatabaseWorkerPool
+{
+public:
+    QueryResult Query(std::string const& /*sql*/) { return nullptr; }
+    QueryCallback AsyncQuery(std::string const& /*sql*/) { return QueryCallback(); }
+    void Execute(std::string const& /*sql*/) {}
+    CharacterDatabaseTransaction BeginTransaction() { return std::make_shared<Transaction>(); }
+    void CommitTransaction(CharacterDatabaseTransaction /*trans*/) {}
+    void DirectCommitTransaction(CharacterDatabaseTransaction& /*trans*/) {}
+};
+
+inline CharacterDatabaseWorkerPool CharacterDatabase;
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_H
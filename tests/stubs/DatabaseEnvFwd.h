@@ -0,0 +1,15 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_FWD_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_FWD_H
+
+#include <memory>
+
+class Field;
+class ResultSet;
+class PreparedResultSet;
+class Transaction;
+
+using QueryResult = std::shared_ptr<ResultSet>;
+using PreparedQueryResult = std::shared_ptr<PreparedResultSet>;
+using CharacterDatabaseTransaction = std::shared_ptr<Transaction>;
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_DATABASE_ENV_FWD_H
@@ -0,0 +1,18 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_DEFINE_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_DEFINE_H
+
+// Stand-in for the core's Define.h: only the fixed-width aliases.
+
+#include <cstddef>
+#include <cstdint>
+
+typedef std::int64_t int64;
+typedef std::int32_t int32;
+typedef std::int16_t int16;
+typedef std::int8_t int8;
+typedef std::uint64_t uint64;
+typedef std::uint32_t uint32;
+typedef std::uint16_t uint16;
+typedef std::uint8_t uint8;
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_DEFINE_H
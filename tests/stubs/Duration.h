@@ -0,0 +1,11 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_DURATION_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_DURATION_H
+
+// Stand-in for the core's Duration.h.
+
+#include <chrono>
+
+using Milliseconds = std::chrono::milliseconds;
+using Seconds = std::chrono::seconds;
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_DURATION_H
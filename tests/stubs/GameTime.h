@@ -0,0 +1,20 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_GAME_TIME_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_GAME_TIME_H
+
+// Stand-in for the core's GameTime.h. Game time starts at a realistic server
+// time (the module treats 0 as "never") and only moves when a test or
+// benchmark calls SetGameTime.
+
+#include "Duration.h"
+
+#include <atomic>
+
+namespace GameTime
+{
+inline std::atomic<Seconds::rep> StubNow{ 1700000000 };
+
+inline Seconds GetGameTime() { return Seconds(StubNow.load(std::memory_order_relaxed)); }
+inline void SetGameTime(Seconds now) { StubNow.store(now.count(), std::memory_order_relaxed); }
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_GAME_TIME_H
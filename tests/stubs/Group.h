@@ -0,0 +1,122 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_GROUP_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_GROUP_H
+
+// Stand-in for the core's Group.h. Adding and removing members keeps the
+// member slots, the member references and each Player's group in step. No
+// GroupScript hook runs; callers do what the module's group hooks would.
+
+#include "Player.h"
+
+#include <algorithm>
+#include <list>
+#include <string>
+
+class GroupReference
+{
+public:
+    Player* GetSource() const { return _source; }
+    GroupReference* next() { return _next; }
+
+private:
+    friend class Group;
+
+    Player* _source = nullptr;
+    GroupReference* _next = nullptr;
+};
+
+class Group
+{
+public:
+    struct MemberSlot
+    {
+        ObjectGuid guid;
+        std::string name;
+    };
+
+    typedef std::list<MemberSlot> MemberSlotList;
+
+    // guidLow 0 is a group still being formed, not yet saved.
+    explicit Group(uint32 guidLow = 0) : _guid(guidLow) {}
+
+    ~Group()
+    {
+        for (GroupReference& ref : _references)
+            ref._source->SetGroup(nullptr);
+    }
+
+    Group(Group const&) = delete;
+    Group& operator=(Group const&) = delete;
+
+    bool AddMember(Player* player)
+    {
+        if (_leaderGuid.IsEmpty())
+            _leaderGuid = player->GetGUID();
+
+        _memberSlots.push_back({ player->GetGUID(), player->GetName() });
+        GroupReference ref;
+        ref._source = player;
+        _references.push_back(ref);
+        Relink();
+        player->SetGroup(this);
+        return true;
+    }
+
+    bool RemoveMember(ObjectGuid guid, RemoveMethod const& /*method*/ = GROUP_REMOVEMETHOD_DEFAULT)
+    {
+        _memberSlots.remove_if([guid](MemberSlot const& slot) { return slot.guid == guid; });
+        _references.remove_if([guid](GroupReference const& ref)
+        {
+            if (ref._source->GetGUID() != guid)
+                return false;
+
+            ref._source->SetGroup(nullptr);
+            return true;
+        });
+
+        Relink();
+        if (_leaderGuid == guid)
+            _leaderGuid = _memberSlots.empty() ? ObjectGuid() : _memberSlots.front().guid;
+        return true;
+    }
+
+    void ConvertToLFG() { _lfg = true; }
+
+    MemberSlotList const& GetMemberSlots() const { return _memberSlots; }
+    GroupReference* GetFirstMember() { return _references.empty() ? nullptr : &_references.front(); }
+    uint32 GetMembersCount() const { return static_cast<uint32>(_memberSlots.size()); }
+    ObjectGuid GetGUID() const { return _guid; }
+    ObjectGuid GetLeaderGUID() const { return _leaderGuid; }
+    bool isLFGGroup() const { return _lfg; }
+    bool isRaidGroup() const { return _memberSlots.size() > 5; }
+
+private:
+    void Relink()
+    {
+        GroupReference* next = nullptr;
+        for (auto itr = _references.rbegin(); itr != _references.rend(); ++itr)
+        {
+            itr->_next = next;
+            next = &*itr;
+        }
+    }
+
+    ObjectGuid _guid;
+    ObjectGuid _leaderGuid;
+    bool _lfg = false;
+    MemberSlotList _memberSlots;
+    std::list<GroupReference> _references;
+};
+
+inline Player::~Player()
+{
+    if (_group)
+        _group->RemoveMember(GetGUID());
+}
+
+inline void Player::RemoveFromGroup(RemoveMethod method)
+{
+    if (_group)
+        _group->RemoveMember(GetGUID(), method);
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_GROUP_H
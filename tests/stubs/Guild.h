@@ -0,0 +1,32 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_H
+
+// Stand-in for the core's Guild.h: an id, a name and a member list.
+
+#include "ObjectGuid.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class Guild
+{
+public:
+    Guild(uint32 id, std::string name) : _id(id), _name(std::move(name)) {}
+
+    uint32 GetId() const { return _id; }
+    std::string const& GetName() const { return _name; }
+
+    bool AddMember(ObjectGuid guid, uint8 /*rankId*/ = 0)
+    {
+        _members.push_back(guid);
+        return true;
+    }
+
+private:
+    uint32 _id;
+    std::string _name;
+    std::vector<ObjectGuid> _members;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_H
@@ -0,0 +1,39 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_MGR_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_MGR_H
+
+// Stand-in for the core's GuildMgr.h: guilds the caller adds, found by name.
+
+#include "Guild.h"
+
+#include <memory>
+#include <vector>
+
+class GuildMgr
+{
+public:
+    static GuildMgr* instance()
+    {
+        static GuildMgr instance;
+        return &instance;
+    }
+
+    void AddGuild(Guild* guild) { _guilds.emplace_back(guild); }
+
+    Guild* GetGuildByName(std::string const& name) const
+    {
+        for (std::unique_ptr<Guild> const& guild : _guilds)
+        {
+            if (guild->GetName() == name)
+                return guild.get();
+        }
+
+        return nullptr;
+    }
+
+private:
+    std::vector<std::unique_ptr<Guild>> _guilds;
+};
+
+#define sGuildMgr GuildMgr::instance()
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_GUILD_MGR_H
@@ -0,0 +1,68 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_ITEM_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_ITEM_H
+
+// Stand-in for the core's Item.h: template quality and creator, and the
+// slot and store constants the module uses. Saving is a no-op.
+
+#include "DatabaseEnvFwd.h"
+#include "Object.h"
+#include "UpdateFields.h"
+
+#include <vector>
+
+struct ItemTemplate
+{
+    uint32 ItemId = 0;
+    uint32 Quality = 0;
+};
+
+enum EquipmentSlots : uint8
+{
+    EQUIPMENT_SLOT_START = 0,
+    EQUIPMENT_SLOT_END = 19
+};
+
+enum InventorySlots : uint8
+{
+    INVENTORY_SLOT_BAG_0 = 255
+};
+
+enum : uint8
+{
+    NULL_BAG = 0,
+    NULL_SLOT = 255
+};
+
+enum InventoryResult : uint8
+{
+    EQUIP_ERR_OK = 0,
+    EQUIP_ERR_INV_FULL = 50
+};
+
+struct ItemPosCount
+{
+    uint16 pos = 0;
+    uint32 count = 0;
+};
+
+typedef std::vector<ItemPosCount> ItemPosCountVec;
+
+class Item : public Object
+{
+public:
+    Item(uint32 guidLow, ItemTemplate const* proto, ObjectGuid creator = ObjectGuid())
+        : Object(ObjectGuid(guidLow)), _proto(proto), _creator(creator) {}
+
+    ItemTemplate const* GetTemplate() const { return _proto; }
+    uint32 GetEntry() const { return _proto ? _proto->ItemId : 0; }
+    ObjectGuid GetGuidValue(uint16 index) const { return index == ITEM_FIELD_CREATOR ? _creator : ObjectGuid(); }
+
+    void DeleteFromInventoryDB(CharacterDatabaseTransaction /*trans*/) {}
+    void SaveToDB(CharacterDatabaseTransaction /*trans*/) {}
+
+private:
+    ItemTemplate const* _proto;
+    ObjectGuid _creator;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_ITEM_H
@@ -0,0 +1,71 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_MAIL_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_MAIL_H
+
+// Stand-in for the core's Mail.h. Drafts are built but never delivered.
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class Item;
+class Object;
+class Player;
+
+enum MailStationery
+{
+    MAIL_STATIONERY_DEFAULT = 41,
+    MAIL_STATIONERY_GM = 61
+};
+
+enum MailCheckMask
+{
+    MAIL_CHECK_MASK_NONE = 0x00,
+    MAIL_CHECK_MASK_READ = 0x01,
+    MAIL_CHECK_MASK_RETURNED = 0x02,
+    MAIL_CHECK_MASK_COPIED = 0x04
+};
+
+constexpr uint32 MAX_MAIL_ITEMS = 12;
+
+class MailSender
+{
+public:
+    MailSender(Object* /*sender*/, MailStationery /*stationery*/ = MAIL_STATIONERY_DEFAULT) {}
+};
+
+class MailReceiver
+{
+public:
+    MailReceiver(Player* receiver) : _receiver(receiver) {}
+
+    Player* GetPlayer() const { return _receiver; }
+
+private:
+    Player* _receiver;
+};
+
+class MailDraft
+{
+public:
+    MailDraft(std::string subject, std::string body) : _subject(std::move(subject)), _body(std::move(body)) {}
+
+    MailDraft& AddItem(Item* item)
+    {
+        _items.push_back(item);
+        return *this;
+    }
+
+    void SendMailTo(CharacterDatabaseTransaction /*trans*/, MailReceiver const& /*receiver*/, MailSender const& /*sender*/,
+                    MailCheckMask /*checked*/ = MAIL_CHECK_MASK_NONE, uint32 /*deliver_delay*/ = 0,
+                    uint32 /*custom_expiration*/ = 0, bool /*deleteMailItemsFromDB*/ = false, bool /*sendMail*/ = true) {}
+
+private:
+    std::string _subject;
+    std::string _body;
+    std::vector<Item*> _items;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_MAIL_H
@@ -0,0 +1,112 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_MYSQL_CONNECTION_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_MYSQL_CONNECTION_H
+
+// Stand-in for the core's MySQLConnection.h. There is no server: Open
+// always succeeds, queries return no rows, and every prepare and call is
+// recorded in MySQLStub for tests to inspect.
+
+#include "Define.h"
+#include "PreparedStatement.h"
+#include "QueryResult.h"
+
+#include <algorithm>
+#include <fmt/ranges.h>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+enum ConnectionFlags
+{
+    CONNECTION_ASYNC = 0x1,
+    CONNECTION_SYNCH = 0x2,
+    CONNECTION_BOTH = CONNECTION_ASYNC | CONNECTION_SYNCH
+};
+
+struct MySQLConnectionInfo
+{
+    explicit MySQLConnectionInfo(std::string_view infoString) : info(infoString) {}
+
+    std::string info;
+};
+
+struct MySQLStubLog
+{
+    std::mutex lock;
+    std::map<uint32, std::string> prepared;
+    // "BEGIN", "COMMIT", "ROLLBACK", "QUERY <index>" and "EXECUTE <index> <parameters>".
+    std::vector<std::string> calls;
+
+    void Record(std::string call)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        calls.push_back(std::move(call));
+    }
+};
+
+inline MySQLStubLog MySQLStub;
+
+class MySQLConnection
+{
+public:
+    MySQLConnection(MySQLConnectionInfo& /*connInfo*/, ConnectionFlags connectionFlags = CONNECTION_SYNCH)
+        : m_connectionFlags(connectionFlags) {}
+    virtual ~MySQLConnection() = default;
+
+    virtual uint32 Open() { return 0; }
+    void Close() {}
+
+    bool PrepareStatements()
+    {
+        DoPrepareStatements();
+        return !m_prepareError;
+    }
+
+    // Fails like the server would for an unprepared statement or a parameter left unbound.
+    bool Execute(PreparedStatementBase* stmt)
+    {
+        std::vector<std::string> const& parameters = stmt->GetParameters();
+        if (stmt->GetIndex() >= m_stmts.size() || m_stmts[stmt->GetIndex()].empty() ||
+            static_cast<size_t>(std::count(m_stmts[stmt->GetIndex()].begin(), m_stmts[stmt->GetIndex()].end(), '?')) != parameters.size() ||
+            std::any_of(parameters.begin(), parameters.end(), [](std::string const& value) { return value.empty(); }))
+            return false;
+
+        MySQLStub.Record(fmt::format("EXECUTE {} {}", stmt->GetIndex(), fmt::join(parameters, ",")));
+        return true;
+    }
+
+    PreparedResultSet* Query(PreparedStatementBase* stmt)
+    {
+        MySQLStub.Record(fmt::format("QUERY {}", stmt->GetIndex()));
+        return nullptr;
+    }
+
+    void BeginTransaction() { MySQLStub.Record("BEGIN"); }
+    void RollbackTransaction() { MySQLStub.Record("ROLLBACK"); }
+    void CommitTransaction() { MySQLStub.Record("COMMIT"); }
+
+protected:
+    void PrepareStatement(uint32 index, std::string_view sql, ConnectionFlags flags)
+    {
+        if (!(m_connectionFlags & flags))
+            return;
+
+        m_stmts[index] = std::string(sql);
+
+        std::lock_guard<std::mutex> guard(MySQLStub.lock);
+        MySQLStub.prepared[index] = std::string(sql);
+    }
+
+    virtual void DoPrepareStatements() = 0;
+
+    // The core holds MySQLPreparedStatement handles; the SQL is enough here.
+    std::vector<std::string> m_stmts;
+    bool m_reconnecting = false;
+    bool m_prepareError = false;
+
+private:
+    ConnectionFlags m_connectionFlags;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_MYSQL_CONNECTION_H
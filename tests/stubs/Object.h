@@ -0,0 +1,61 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_H
+
+// Stand-in for the core's Object.h: identity, CustomData, name and position.
+
+#include "Common.h"
+#include "DataMap.h"
+#include "ObjectGuid.h"
+
+#include <string>
+
+class Object
+{
+public:
+    virtual ~Object() = default;
+
+    ObjectGuid GetGUID() const { return _guid; }
+
+    DataMap CustomData;
+
+protected:
+    explicit Object(ObjectGuid guid) : _guid(guid) {}
+
+private:
+    ObjectGuid _guid;
+};
+
+class WorldObject : public Object
+{
+public:
+    std::string const& GetName() const { return _name; }
+    void SetName(std::string const& name) { _name = name; }
+
+    uint32 GetMapId() const { return _mapId; }
+    float GetPositionX() const { return _x; }
+    float GetPositionY() const { return _y; }
+    float GetPositionZ() const { return _z; }
+    float GetOrientation() const { return _o; }
+
+    void Relocate(uint32 mapId, float x, float y, float z, float o)
+    {
+        _mapId = mapId;
+        _x = x;
+        _y = y;
+        _z = z;
+        _o = o;
+    }
+
+protected:
+    explicit WorldObject(ObjectGuid guid) : Object(guid) {}
+
+private:
+    std::string _name;
+    uint32 _mapId = 0;
+    float _x = 0.0f;
+    float _y = 0.0f;
+    float _z = 0.0f;
+    float _o = 0.0f;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_H
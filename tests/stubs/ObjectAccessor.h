@@ -0,0 +1,39 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_ACCESSOR_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_ACCESSOR_H
+
+// Stand-in for the core's ObjectAccessor.h: the players the caller has added
+// with AddObject, found by guid or name.
+
+#include "Player.h"
+
+#include <string>
+#include <unordered_map>
+
+namespace ObjectAccessor
+{
+inline std::unordered_map<uint32, Player*> StubPlayers;
+
+inline void AddObject(Player* player) { StubPlayers[player->GetGUID().GetCounter()] = player; }
+inline void RemoveObject(Player* player) { StubPlayers.erase(player->GetGUID().GetCounter()); }
+
+inline Player* FindPlayerByLowGUID(uint32 lowguid)
+{
+    auto itr = StubPlayers.find(lowguid);
+    return itr != StubPlayers.end() ? itr->second : nullptr;
+}
+
+inline Player* FindConnectedPlayer(ObjectGuid guid) { return FindPlayerByLowGUID(guid.GetCounter()); }
+
+inline Player* FindPlayerByName(std::string const& name, bool /*checkInWorld*/ = true)
+{
+    for (auto const& [guid, player] : StubPlayers)
+    {
+        if (player->GetName() == name)
+            return player;
+    }
+
+    return nullptr;
+}
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_ACCESSOR_H
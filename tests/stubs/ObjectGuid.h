@@ -0,0 +1,29 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_GUID_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_GUID_H
+
+// Stand-in for the core's ObjectGuid.h. Only player guids exist here, so the
+// low counter is the whole guid.
+
+#include "Define.h"
+
+class ObjectGuid
+{
+public:
+    ObjectGuid() = default;
+    explicit ObjectGuid(uint32 counter) : _counter(counter) {}
+
+    uint32 GetCounter() const { return _counter; }
+    uint64 GetRawValue() const { return _counter; }
+    bool IsEmpty() const { return _counter == 0; }
+    bool IsPlayer() const { return _counter != 0; }
+
+    explicit operator bool() const { return !IsEmpty(); }
+    bool operator==(ObjectGuid const& other) const { return _counter == other._counter; }
+    bool operator!=(ObjectGuid const& other) const { return _counter != other._counter; }
+    bool operator<(ObjectGuid const& other) const { return _counter < other._counter; }
+
+private:
+    uint32 _counter = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_OBJECT_GUID_H
@@ -0,0 +1,11 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_OPTIONAL_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_OPTIONAL_H
+
+// Stand-in for the core's Optional.h.
+
+#include <optional>
+
+template<class T>
+using Optional = std::optional<T>;
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_OPTIONAL_H
@@ -0,0 +1,119 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_PLAYER_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_PLAYER_H
+
+// Stand-in for the core's Player.h: the state ChallengeManager reads and
+// changes, kept in plain members. Group membership goes through Group
+// (Group.h, included at the end).
+
+#include "Item.h"
+#include "SharedDefines.h"
+#include "Unit.h"
+#include "WorldSession.h"
+
+#include <array>
+#include <memory>
+
+class Group;
+
+enum PlayerXPSource : uint8
+{
+    XPSOURCE_KILL = 0,
+    XPSOURCE_QUEST = 1,
+    XPSOURCE_QUEST_DF = 2,
+    XPSOURCE_EXPLORE = 3,
+    XPSOURCE_BATTLEGROUND = 4
+};
+
+enum DuelState
+{
+    DUEL_STATE_CHALLENGED,
+    DUEL_STATE_COUNTDOWN,
+    DUEL_STATE_IN_PROGRESS,
+    DUEL_STATE_COMPLETED
+};
+
+struct DuelInfo
+{
+    DuelState State = DUEL_STATE_CHALLENGED;
+};
+
+class Player : public Unit
+{
+public:
+    Player(uint32 guidLow, WorldSession* session) : Unit(ObjectGuid(guidLow)), _session(session)
+    {
+        if (session)
+            session->SetPlayer(this);
+    }
+
+    ~Player() override;
+
+    WorldSession* GetSession() const { return _session; }
+
+    Group* GetGroup() const { return _group; }
+    void SetGroup(Group* group) { _group = group; }
+    void RemoveFromGroup(RemoveMethod method = GROUP_REMOVEMETHOD_DEFAULT);
+
+    uint32 GetGuildId() const { return _guildId; }
+    void SetInGuild(uint32 guildId) { _guildId = guildId; }
+
+    uint8 GetLevel() const { return _level; }
+    void SetLevel(uint8 level) { _level = level; }
+
+    uint32 GetMoney() const { return _money; }
+    void SetMoney(uint32 value) { _money = value; }
+
+    uint32 GetFreeTalentPoints() const { return _freeTalentPoints; }
+    void SetFreeTalentPoints(uint32 points) { _freeTalentPoints = points; }
+    void SendTalentsInfoData(bool /*pet*/) {}
+
+    bool InArena() const { return false; }
+    bool InBattleground() const { return false; }
+
+    // Equipment slots hold items the caller owns; the bags only count free space.
+    Item* GetItemByPos(uint8 bag, uint8 slot) const
+    {
+        return bag == INVENTORY_SLOT_BAG_0 && slot < EQUIPMENT_SLOT_END ? _equipment[slot] : nullptr;
+    }
+
+    void SetEquipped(uint8 slot, Item* item) { _equipment[slot] = item; }
+    void SetFreeBagSlots(uint32 slots) { _freeBagSlots = slots; }
+
+    InventoryResult CanStoreItem(uint8 /*bag*/, uint8 /*slot*/, ItemPosCountVec& dest, Item* /*item*/, bool /*swap*/) const
+    {
+        if (!_freeBagSlots)
+            return EQUIP_ERR_INV_FULL;
+
+        dest.push_back({ 0, 1 });
+        return EQUIP_ERR_OK;
+    }
+
+    void RemoveItem(uint8 bag, uint8 slot, bool /*update*/) { MoveItemFromInventory(bag, slot, false); }
+    Item* StoreItem(ItemPosCountVec const& /*dest*/, Item* item, bool /*update*/)
+    {
+        --_freeBagSlots;
+        return item;
+    }
+
+    void MoveItemFromInventory(uint8 bag, uint8 slot, bool /*update*/)
+    {
+        if (bag == INVENTORY_SLOT_BAG_0 && slot < EQUIPMENT_SLOT_END)
+            _equipment[slot] = nullptr;
+    }
+
+    std::unique_ptr<DuelInfo> duel;
+
+private:
+    WorldSession* _session;
+    Group* _group = nullptr;
+    uint32 _guildId = 0;
+    uint8 _level = 1;
+    uint32 _money = 0;
+    uint32 _freeTalentPoints = 0;
+    std::array<Item*, EQUIPMENT_SLOT_END> _equipment = {};
+    uint32 _freeBagSlots = 16;
+};
+
+#include "Group.h"
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_PLAYER_H
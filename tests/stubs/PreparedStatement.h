@@ -0,0 +1,38 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_PREPARED_STATEMENT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_PREPARED_STATEMENT_H
+
+// Stand-in for the core's PreparedStatement.h: bound values are kept as
+// text so tests can check what a statement was executed with.
+
+#include "Define.h"
+
+#include <fmt/format.h>
+#include <string>
+#include <vector>
+
+class PreparedStatementBase
+{
+public:
+    PreparedStatementBase(uint32 index, uint8 capacity) : _index(index), _parameters(capacity) {}
+    virtual ~PreparedStatementBase() = default;
+
+    template<typename T>
+    void SetData(uint8 index, T value) { _parameters.at(index) = fmt::format("{}", value); }
+
+    uint32 GetIndex() const { return _index; }
+    // Unbound parameters are empty.
+    std::vector<std::string> const& GetParameters() const { return _parameters; }
+
+private:
+    uint32 _index;
+    std::vector<std::string> _parameters;
+};
+
+template<typename T>
+class PreparedStatement : public PreparedStatementBase
+{
+public:
+    PreparedStatement(uint32 index, uint8 capacity) : PreparedStatementBase(index, capacity) {}
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_PREPARED_STATEMENT_H
@@ -0,0 +1,38 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_QUERY_RESULT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_QUERY_RESULT_H
+
+// Stand-in for the core's QueryResult.h and Field.h. Result sets are empty.
+
+#include "DatabaseEnvFwd.h"
+#include "Define.h"
+
+class Field
+{
+public:
+    template<typename T>
+    T Get() const { return T(); }
+};
+
+class ResultSet
+{
+public:
+    Field* Fetch() { return &_field; }
+    bool NextRow() { return false; }
+    uint64 GetRowCount() const { return 0; }
+
+private:
+    Field _field;
+};
+
+class PreparedResultSet
+{
+public:
+    Field* Fetch() { return &_field; }
+    bool NextRow() { return false; }
+    uint64 GetRowCount() const { return 0; }
+
+private:
+    Field _field;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_QUERY_RESULT_H
@@ -0,0 +1,27 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_SHARED_DEFINES_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_SHARED_DEFINES_H
+
+// Stand-in for the core's SharedDefines.h: the enums the module reads.
+
+#include "Define.h"
+
+enum Language : uint32
+{
+    LANG_UNIVERSAL = 0,
+    LANG_ADDON = 0xFFFFFFFF
+};
+
+enum RemoveMethod
+{
+    GROUP_REMOVEMETHOD_DEFAULT = 0,
+    GROUP_REMOVEMETHOD_KICK = 1,
+    GROUP_REMOVEMETHOD_LEAVE = 2,
+    GROUP_REMOVEMETHOD_KICK_LFG = 3
+};
+
+enum ServerMessageType
+{
+    SERVER_MSG_STRING = 3
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_SHARED_DEFINES_H
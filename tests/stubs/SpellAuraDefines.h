@@ -0,0 +1,14 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURA_DEFINES_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURA_DEFINES_H
+
+// Stand-in for the core's SpellAuraDefines.h: the aura types the module reads.
+
+#include "Define.h"
+
+enum AuraType : uint32
+{
+    SPELL_AURA_NONE = 0,
+    SPELL_AURA_MOUNTED = 78
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURA_DEFINES_H
@@ -0,0 +1,32 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURAS_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURAS_H
+
+// Stand-in for the core's SpellAuras.h. An aura is its spell id; the spell's
+// facts come from the stand-in spell store.
+
+#include "SpellMgr.h"
+
+class Aura
+{
+public:
+    explicit Aura(uint32 spellId) : _spellId(spellId) {}
+
+    uint32 GetId() const { return _spellId; }
+    SpellInfo const* GetSpellInfo() const { return sSpellMgr->GetSpellInfo(_spellId); }
+
+private:
+    uint32 _spellId;
+};
+
+class AuraApplication
+{
+public:
+    explicit AuraApplication(Aura* base) : _base(base) {}
+
+    Aura* GetBase() const { return _base; }
+
+private:
+    Aura* _base;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_AURAS_H
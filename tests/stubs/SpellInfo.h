@@ -0,0 +1,27 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_INFO_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_INFO_H
+
+#include "Define.h"
+#include "SpellAuraDefines.h"
+
+// Stand-in for the core's SpellInfo: only the facts ChallengeSpellTable reads.
+
+class SpellInfo
+{
+public:
+    SpellInfo(uint32 id, bool positive, bool passive, AuraType aura)
+        : Id(id), _positive(positive), _passive(passive), _aura(aura) { }
+
+    bool IsPositive() const { return _positive; }
+    bool IsPassive() const { return _passive; }
+    bool HasAura(AuraType aura) const { return aura != SPELL_AURA_NONE && aura == _aura; }
+
+    uint32 const Id;
+
+private:
+    bool _positive;
+    bool _passive;
+    AuraType _aura;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_INFO_H
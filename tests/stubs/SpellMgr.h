@@ -0,0 +1,27 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_MGR_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_MGR_H
+
+#include "SpellInfo.h"
+
+#include <memory>
+#include <vector>
+
+// Stand-in for the core's SpellMgr: a spell store the caller fills in.
+class SpellMgr
+{
+public:
+    static SpellMgr* instance()
+    {
+        static SpellMgr instance;
+        return &instance;
+    }
+
+    uint32 GetSpellInfoStoreSize() const { return static_cast<uint32>(store.size()); }
+    SpellInfo const* GetSpellInfo(uint32 spellId) const { return spellId < store.size() ? store[spellId].get() : nullptr; }
+
+    std::vector<std::unique_ptr<SpellInfo>> store;
+};
+
+#define sSpellMgr SpellMgr::instance()
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_SPELL_MGR_H
@@ -0,0 +1,50 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_CONVERT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_CONVERT_H
+
+// Stand-in for the core's StringConvert.h: decimal numbers, and booleans as
+// 0/1 or true/false.
+
+#include <charconv>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Acore
+{
+template<typename T>
+std::optional<T> StringTo(std::string_view str)
+{
+    while (!str.empty() && (str.front() == ' ' || str.front() == '\t'))
+        str.remove_prefix(1);
+    while (!str.empty() && (str.back() == ' ' || str.back() == '\t'))
+        str.remove_suffix(1);
+
+    if constexpr (std::is_same_v<T, std::string>)
+        return std::string(str);
+    else if constexpr (std::is_same_v<T, bool>)
+    {
+        if (str == "1" || str == "true")
+            return true;
+        if (str == "0" || str == "false")
+            return false;
+        return std::nullopt;
+    }
+    else
+    {
+        T value{};
+        auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if (ec != std::errc() || end != str.data() + str.size())
+            return std::nullopt;
+        return value;
+    }
+}
+
+template<typename T>
+std::string ToString(T value)
+{
+    return std::to_string(value);
+}
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_CONVERT_H
@@ -0,0 +1,20 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_FORMAT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_FORMAT_H
+
+// Stand-in for the core's StringFormat.h.
+
+#include <fmt/format.h>
+
+#include <string>
+#include <utility>
+
+namespace Acore
+{
+template<typename... Args>
+std::string StringFormat(fmt::format_string<Args...> fmt, Args&&... args)
+{
+    return fmt::format(fmt, std::forward<Args>(args)...);
+}
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_STRING_FORMAT_H
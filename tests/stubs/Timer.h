@@ -0,0 +1,19 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_TIMER_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_TIMER_H
+
+#include "Define.h"
+
+#include <chrono>
+
+inline uint32 getMSTime()
+{
+    using namespace std::chrono;
+    return uint32(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count());
+}
+
+inline uint32 GetMSTimeDiffToNow(uint32 oldMSTime)
+{
+    return getMSTime() - oldMSTime;
+}
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_TIMER_H
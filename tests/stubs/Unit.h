@@ -0,0 +1,89 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_UNIT_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_UNIT_H
+
+// Stand-in for the core's Unit.h: a unit owns its auras, one application
+// each, and is mounted while it has a SPELL_AURA_MOUNTED aura.
+
+#include "Object.h"
+#include "SpellAuras.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <vector>
+
+class Player;
+
+class Unit : public WorldObject
+{
+public:
+    typedef std::multimap<uint32, AuraApplication*> AuraApplicationMap;
+
+    AuraApplicationMap const& GetAppliedAuras() const { return _appliedAuras; }
+
+    // The core casts spellId on target; here the aura is simply applied.
+    Aura* AddAura(uint32 spellId, Unit* target)
+    {
+        return target->ApplyAura(spellId);
+    }
+
+    bool HasAura(uint32 spellId) const { return _appliedAuras.count(spellId) != 0; }
+
+    bool HasAuraType(AuraType type) const
+    {
+        return std::any_of(_auras.begin(), _auras.end(), [type](AuraSlot const& slot)
+        {
+            SpellInfo const* spellInfo = slot.aura->GetSpellInfo();
+            return spellInfo && spellInfo->HasAura(type);
+        });
+    }
+
+    void RemoveAura(uint32 spellId)
+    {
+        _appliedAuras.erase(spellId);
+        _auras.erase(std::remove_if(_auras.begin(), _auras.end(),
+            [spellId](AuraSlot const& slot) { return slot.aura->GetId() == spellId; }), _auras.end());
+    }
+
+    void RemoveAurasByType(AuraType type)
+    {
+        std::vector<uint32> spells;
+        for (AuraSlot const& slot : _auras)
+        {
+            SpellInfo const* spellInfo = slot.aura->GetSpellInfo();
+            if (spellInfo && spellInfo->HasAura(type))
+                spells.push_back(slot.aura->GetId());
+        }
+
+        for (uint32 spellId : spells)
+            RemoveAura(spellId);
+    }
+
+    bool IsMounted() const { return HasAuraType(SPELL_AURA_MOUNTED); }
+    void Dismount() {}
+
+protected:
+    explicit Unit(ObjectGuid guid) : WorldObject(guid) {}
+
+private:
+    struct AuraSlot
+    {
+        std::unique_ptr<Aura> aura;
+        std::unique_ptr<AuraApplication> application;
+    };
+
+    Aura* ApplyAura(uint32 spellId)
+    {
+        AuraSlot slot;
+        slot.aura = std::make_unique<Aura>(spellId);
+        slot.application = std::make_unique<AuraApplication>(slot.aura.get());
+        _appliedAuras.emplace(spellId, slot.application.get());
+        _auras.push_back(std::move(slot));
+        return _auras.back().aura.get();
+    }
+
+    std::vector<AuraSlot> _auras;
+    AuraApplicationMap _appliedAuras;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_UNIT_H
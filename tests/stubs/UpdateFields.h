@@ -0,0 +1,11 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_UPDATE_FIELDS_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_UPDATE_FIELDS_H
+
+// Stand-in for the core's UpdateFields.h: the one field the module reads.
+
+enum EItemFields
+{
+    ITEM_FIELD_CREATOR = 0x000A
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_UPDATE_FIELDS_H
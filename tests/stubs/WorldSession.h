@@ -0,0 +1,39 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_H
+
+// Stand-in for the core's WorldSession.h. IsBot is the playerbots branch's
+// addition. Chat sent to the session is counted instead of delivered.
+
+#include "Define.h"
+
+#include <ctime>
+#include <string>
+
+class Player;
+
+class WorldSession
+{
+public:
+    explicit WorldSession(uint32 accountId, bool bot = false) : _accountId(accountId), _bot(bot) {}
+
+    uint32 GetAccountId() const { return _accountId; }
+    bool IsBot() const { return _bot; }
+
+    Player* GetPlayer() const { return _player; }
+    void SetPlayer(Player* player) { _player = player; }
+
+    void SetLogoutStartTime(time_t requestTime) { _logoutTime = requestTime; }
+    time_t GetLogoutStartTime() const { return _logoutTime; }
+
+    // System messages and notifications sent through ChatHandler.
+    uint32 messageCount = 0;
+    std::string lastMessage;
+
+private:
+    uint32 _accountId;
+    bool _bot;
+    Player* _player = nullptr;
+    time_t _logoutTime = 0;
+};
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_H
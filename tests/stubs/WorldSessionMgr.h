@@ -0,0 +1,26 @@
+#ifndef MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_MGR_H
+#define MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_MGR_H
+
+// Stand-in for the core's WorldSessionMgr.h: server messages go nowhere.
+
+#include "SharedDefines.h"
+
+#include <string>
+
+class Player;
+
+class WorldSessionMgr
+{
+public:
+    static WorldSessionMgr* instance()
+    {
+        static WorldSessionMgr instance;
+        return &instance;
+    }
+
+    void SendServerMessage(ServerMessageType /*messageID*/, std::string const& /*text*/, Player* /*player*/ = nullptr) {}
+};
+
+#define sWorldSessionMgr WorldSessionMgr::instance()
+
+#endif // MOD_IP_CHALLENGESYSTEM_TEST_STUB_WORLD_SESSION_MGR_H
@@ -0,0 +1,73 @@
+#include "ChallengeAccountIndex.h"
+
+#include <gtest/gtest.h>
+
+TEST(ChallengeAccountIndexTest, HardcoreOnlyWhenEveryCharacterIs)
+{
+    ChallengeAccountIndex& index = ChallengeAccountIndex::Instance();
+    constexpr uint32 account = 501;
+
+    EXPECT_FALSE(index.IsHardcore(account));
+
+    index.AddCharacter(account);
+    EXPECT_FALSE(index.IsHardcore(account));
+
+    index.UpdateHardcore(account, false, true);
+    EXPECT_TRUE(index.IsHardcore(account));
+
+    // A new character starts without a tier.
+    index.AddCharacter(account);
+    EXPECT_FALSE(index.IsHardcore(account));
+
+    index.UpdateHardcore(account, false, true);
+    EXPECT_TRUE(index.IsHardcore(account));
+
+    index.UpdateHardcore(account, true, false);
+    EXPECT_FALSE(index.IsHardcore(account));
+}
+
+TEST(ChallengeAccountIndexTest, UnchangedStateLeavesCountsAlone)
+{
+    ChallengeAccountIndex& index = ChallengeAccountIndex::Instance();
+    constexpr uint32 account = 502;
+
+    index.AddCharacter(account);
+    index.AddCharacter(account);
+    index.UpdateHardcore(account, false, true);
+
+    // Republishing the same state (login, logout) must not count twice.
+    index.UpdateHardcore(account, true, true);
+    index.UpdateHardcore(account, false, false);
+    EXPECT_FALSE(index.IsHardcore(account));
+
+    index.UpdateHardcore(account, false, true);
+    EXPECT_TRUE(index.IsHardcore(account));
+}
+
+TEST(ChallengeAccountIndexTest, DeletingTheLastSoftcoreCharacterMakesTheAccountHardcore)
+{
+    ChallengeAccountIndex& index = ChallengeAccountIndex::Instance();
+    constexpr uint32 account = 503;
+
+    index.AddCharacter(account);
+    index.AddCharacter(account);
+    index.UpdateHardcore(account, false, true);
+    EXPECT_FALSE(index.IsHardcore(account));
+
+    index.RemoveCharacter(account, false);
+    EXPECT_TRUE(index.IsHardcore(account));
+
+    index.RemoveCharacter(account, true);
+    EXPECT_FALSE(index.IsHardcore(account));
+    EXPECT_EQ(index.Size(), 0u);
+}
+
+TEST(ChallengeAccountIndexTest, UnknownAccountsAreIgnored)
+{
+    ChallengeAccountIndex& index = ChallengeAccountIndex::Instance();
+
+    index.UpdateHardcore(504, false, true);
+    index.RemoveCharacter(504, true);
+    EXPECT_FALSE(index.IsHardcore(504));
+    EXPECT_EQ(index.Size(), 0u);
+}
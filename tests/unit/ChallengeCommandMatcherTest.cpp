@@ -0,0 +1,92 @@
+#include "ChallengeCommandMatcher.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+ChallengeCommandMatcher MakeCombatMatcher()
+{
+    ChallengeCommandMatcher matcher;
+    for (char const* phrase : { "attack", "tank attack", "max dps", "cast", "castnc", "co", "nc", "pull", "rti" })
+        matcher.Add(phrase, BotCommandKind::Combat);
+    return matcher;
+}
+}
+
+TEST(ChallengeCommandMatcherTest, EmptyMatcherMatchesNothing)
+{
+    ChallengeCommandMatcher matcher;
+    EXPECT_FALSE(matcher.HasKind(BotCommandKind::Combat));
+    EXPECT_EQ(matcher.Classify("attack").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("").kind, BotCommandKind::None);
+}
+
+TEST(ChallengeCommandMatcherTest, FoldsCaseAndWhitespace)
+{
+    ChallengeCommandMatcher matcher = MakeCombatMatcher();
+    EXPECT_TRUE(matcher.HasKind(BotCommandKind::Combat));
+
+    EXPECT_EQ(matcher.Classify("ATTACK").kind, BotCommandKind::Combat);
+    EXPECT_EQ(matcher.Classify("  Attack").kind, BotCommandKind::Combat);
+    EXPECT_EQ(matcher.Classify("max\t  DPS").kind, BotCommandKind::Combat);
+    EXPECT_EQ(matcher.Classify("Tank   Attack now").kind, BotCommandKind::Combat);
+}
+
+TEST(ChallengeCommandMatcherTest, MatchesWholeWordsOnly)
+{
+    ChallengeCommandMatcher matcher = MakeCombatMatcher();
+
+    EXPECT_EQ(matcher.Classify("co").kind, BotCommandKind::Combat);
+    EXPECT_EQ(matcher.Classify("co +dps").kind, BotCommandKind::Combat);
+    EXPECT_EQ(matcher.Classify("co-op?").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("cool").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("attacking").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("max").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("hello attack").kind, BotCommandKind::None);
+}
+
+TEST(ChallengeCommandMatcherTest, PrefixPhrasesStayDistinct)
+{
+    ChallengeCommandMatcher matcher = MakeCombatMatcher();
+
+    ChallengeCommandMatcher::Match cast = matcher.Classify("cast fireball");
+    EXPECT_EQ(cast.kind, BotCommandKind::Combat);
+    EXPECT_EQ(cast.args, "fireball");
+
+    ChallengeCommandMatcher::Match castnc = matcher.Classify("castnc +frost nova");
+    EXPECT_EQ(castnc.kind, BotCommandKind::Combat);
+    EXPECT_EQ(castnc.args, "+frost nova");
+
+    EXPECT_EQ(matcher.Classify("castn").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("castncx").kind, BotCommandKind::None);
+}
+
+TEST(ChallengeCommandMatcherTest, LongestMultiWordPhraseWins)
+{
+    ChallengeCommandMatcher matcher;
+    matcher.Add(".playerbots bot", BotCommandKind::Add);
+    matcher.Add(".playerbots  bot   addaccount ", BotCommandKind::AddAccount);
+    matcher.Add(".playerbots rndbot", BotCommandKind::RandomBot);
+
+    ChallengeCommandMatcher::Match match = matcher.Classify(".PlayerBots bot addaccount  someone");
+    EXPECT_EQ(match.kind, BotCommandKind::AddAccount);
+    EXPECT_EQ(match.args, "someone");
+
+    match = matcher.Classify(".playerbots bot add Alice,Bob");
+    EXPECT_EQ(match.kind, BotCommandKind::Add);
+    EXPECT_EQ(match.args, "add Alice,Bob");
+
+    EXPECT_EQ(matcher.Classify(".playerbots rndbot init").kind, BotCommandKind::RandomBot);
+    EXPECT_EQ(matcher.Classify(".playerbots").kind, BotCommandKind::None);
+}
+
+TEST(ChallengeCommandMatcherTest, IgnoresEmptyPhrases)
+{
+    ChallengeCommandMatcher matcher;
+    matcher.Add("   ", BotCommandKind::Combat);
+    matcher.Add("attack", BotCommandKind::None);
+
+    EXPECT_FALSE(matcher.HasKind(BotCommandKind::Combat));
+    EXPECT_EQ(matcher.Classify(" ").kind, BotCommandKind::None);
+    EXPECT_EQ(matcher.Classify("attack").kind, BotCommandKind::None);
+}
@@ -0,0 +1,140 @@
+#include "ChallengeDatabase.h"
+#include "MySQLConnection.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+namespace
+{
+ChallengeDatabasePreparedStatement* StateReplace(uint32 guid, uint8 tier, uint32 flags)
+{
+    ChallengeDatabasePreparedStatement* stmt = ChallengeDatabase::Instance().GetPreparedStatement(CHALLENGE_REP_STATE);
+    stmt->SetData(0, guid);
+    stmt->SetData(1, tier);
+    stmt->SetData(2, flags);
+    stmt->SetData(3, uint32(1000));
+    return stmt;
+}
+
+std::vector<std::string> Calls()
+{
+    std::lock_guard<std::mutex> guard(MySQLStub.lock);
+    return MySQLStub.calls;
+}
+
+ChallengeDatabase::StatementStats StatsFor(char const* name)
+{
+    for (ChallengeDatabase::StatementStats const& stats : ChallengeDatabase::Instance().GetStats())
+        if (std::string_view(stats.name) == name)
+            return stats;
+    return {};
+}
+}
+
+TEST(ChallengeDatabaseTest, OpenPreparesEveryStatement)
+{
+    ASSERT_TRUE(ChallengeDatabase::Instance().Open(""));
+
+    EXPECT_EQ(MySQLStub.prepared.size(), size_t(MAX_CHALLENGE_DATABASE_STATEMENTS));
+    EXPECT_EQ(MySQLStub.prepared[CHALLENGE_DEL_STATE], "DELETE FROM ip_challenge_state WHERE guid = ?");
+
+    ChallengeDatabase::Instance().Close();
+}
+
+TEST(ChallengeDatabaseTest, TransactionRunsPreparedExecutesInsideOneTransaction)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+    ASSERT_TRUE(database.Open(""));
+
+    ChallengeDatabaseTransaction trans = database.BeginTransaction();
+    trans->Append(StateReplace(1, 1, 3));
+    trans->Append(StateReplace(2, 2, 5));
+    ChallengeDatabasePreparedStatement* del = database.GetPreparedStatement(CHALLENGE_DEL_STATE);
+    del->SetData(0, uint32(3));
+    trans->Append(del);
+    database.DirectCommitTransaction(trans);
+
+    std::vector<std::string> expected =
+    {
+        "BEGIN",
+        fmt::format("EXECUTE {} 1,1,3,1000", uint32(CHALLENGE_REP_STATE)),
+        fmt::format("EXECUTE {} 2,2,5,1000", uint32(CHALLENGE_REP_STATE)),
+        fmt::format("EXECUTE {} 3", uint32(CHALLENGE_DEL_STATE)),
+        "COMMIT"
+    };
+    EXPECT_EQ(Calls(), expected);
+
+    // Stats count executions on the writer thread, not enqueues.
+    EXPECT_EQ(StatsFor("CHALLENGE_REP_STATE").calls, 2u);
+    EXPECT_EQ(StatsFor("CHALLENGE_DEL_STATE").calls, 1u);
+    EXPECT_EQ(StatsFor("CHALLENGE_REP_STATE").kind, ChallengeDatabase::StatementKind::Execute);
+
+    database.Close();
+}
+
+TEST(ChallengeDatabaseTest, FailedExecuteRollsBackTheTransaction)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+    ASSERT_TRUE(database.Open(""));
+
+    ChallengeDatabaseTransaction trans = database.BeginTransaction();
+    trans->Append(StateReplace(1, 1, 3));
+    // Parameter left unbound.
+    trans->Append(database.GetPreparedStatement(CHALLENGE_DEL_STATE));
+    trans->Append(StateReplace(2, 2, 5));
+    database.DirectCommitTransaction(trans);
+
+    std::vector<std::string> calls = Calls();
+    ASSERT_FALSE(calls.empty());
+    EXPECT_EQ(calls.back(), "ROLLBACK");
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), "COMMIT"), 0);
+
+    database.Close();
+}
+
+TEST(ChallengeDatabaseTest, CloseCommitsQueuedTransactions)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+    ASSERT_TRUE(database.Open(""));
+
+    for (uint32 guid = 1; guid <= 20; ++guid)
+    {
+        ChallengeDatabaseTransaction trans = database.BeginTransaction();
+        trans->Append(StateReplace(guid, 1, 1));
+        database.CommitTransaction(trans);
+    }
+
+    database.Close();
+
+    std::vector<std::string> calls = Calls();
+    EXPECT_EQ(std::count(calls.begin(), calls.end(), "COMMIT"), 20);
+    EXPECT_EQ(StatsFor("CHALLENGE_REP_STATE").calls, 20u);
+}
+
+TEST(ChallengeDatabaseTest, QueriesAndCommitsBeforeOpenAreDropped)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+
+    EXPECT_EQ(database.Query(database.GetPreparedStatement(CHALLENGE_SEL_ALL_STATES)), nullptr);
+
+    ChallengeDatabaseTransaction trans = database.BeginTransaction();
+    trans->Append(StateReplace(1, 1, 3));
+    database.DirectCommitTransaction(trans);
+
+    EXPECT_TRUE(Calls().empty());
+    EXPECT_EQ(StatsFor("CHALLENGE_REP_STATE").calls, 0u);
+}
+
+TEST(ChallengeDatabaseTest, QueryRecordsItsRoundTrip)
+{
+    ChallengeDatabase& database = ChallengeDatabase::Instance();
+    ASSERT_TRUE(database.Open(""));
+
+    EXPECT_EQ(database.Query(database.GetPreparedStatement(CHALLENGE_SEL_ALL_STATES)), nullptr);
+    EXPECT_EQ(Calls(), std::vector<std::string>{ fmt::format("QUERY {}", uint32(CHALLENGE_SEL_ALL_STATES)) });
+    EXPECT_EQ(StatsFor("CHALLENGE_SEL_ALL_STATES").calls, 1u);
+    EXPECT_EQ(StatsFor("CHALLENGE_SEL_ALL_STATES").kind, ChallengeDatabase::StatementKind::Query);
+
+    database.Close();
+}
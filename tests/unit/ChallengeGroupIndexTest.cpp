@@ -0,0 +1,180 @@
+#include "ChallengeGroupIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+ChallengeGroupMember MakeMember(bool soloOnly, bool hardcore, uint8 tier)
+{
+    ChallengeGroupMember member;
+    member.soloOnly = soloOnly;
+    member.hardcore = hardcore;
+    member.tier = tier;
+    return member;
+}
+
+uint32 CountedMembers(ChallengeGroupSummary const& summary)
+{
+    uint32 count = summary.nonHardcore;
+    for (uint32 hardcore : summary.hardcore)
+        count += hardcore;
+    return count;
+}
+}
+
+TEST(ChallengeGroupIndexTest, UnseededGroupHasNoSummary)
+{
+    ChallengeGroupIndex& index = ChallengeGroupIndex::Instance();
+    constexpr uint32 group = 100;
+
+    ChallengeGroupSummary summary;
+    EXPECT_FALSE(index.GetSummary(group, 0, summary));
+
+    uint32 version = index.GetVersion(group);
+    index.SetMember(group, 1, MakeMember(false, true, 1));
+    EXPECT_GT(index.GetVersion(group), version);
+    EXPECT_FALSE(index.GetSummary(group, 0, summary));
+
+    index.Erase(group);
+}
+
+TEST(ChallengeGroupIndexTest, SummaryTracksMembers)
+{
+    ChallengeGroupIndex& index = ChallengeGroupIndex::Instance();
+    constexpr uint32 group = 101;
+
+    index.Seed(group, { { 1, MakeMember(false, true, 2) }, { 2, MakeMember(false, false, 0) } });
+
+    ChallengeGroupSummary summary;
+    ASSERT_TRUE(index.GetSummary(group, 0, summary));
+    EXPECT_EQ(summary.members, 2u);
+    EXPECT_EQ(summary.hardcore[2], 1u);
+    EXPECT_EQ(summary.nonHardcore, 1u);
+
+    ASSERT_TRUE(index.GetSummary(group, 1, summary));
+    EXPECT_EQ(summary.members, 1u);
+    EXPECT_EQ(summary.hardcore[2], 0u);
+
+    // Re-publishing the same state does not invalidate cached validity.
+    uint32 version = index.GetVersion(group);
+    index.SetMember(group, 1, MakeMember(false, true, 2));
+    EXPECT_EQ(index.GetVersion(group), version);
+
+    index.SetMember(group, 2, MakeMember(true, false, 0));
+    EXPECT_GT(index.GetVersion(group), version);
+    ASSERT_TRUE(index.GetSummary(group, 0, summary));
+    EXPECT_EQ(summary.soloOnly, 1u);
+
+    index.RemoveMember(group, 2);
+    ASSERT_TRUE(index.GetSummary(group, 0, summary));
+    EXPECT_EQ(summary.members, 1u);
+    EXPECT_EQ(summary.soloOnly, 0u);
+    EXPECT_EQ(summary.nonHardcore, 0u);
+
+    index.Erase(group);
+    EXPECT_EQ(index.GetVersion(group), 0u);
+}
+
+TEST(ChallengeGroupIndexTest, SoloOnlyNeverJoins)
+{
+    ChallengeGroupSummary empty;
+    EXPECT_FALSE(IsGroupCompatible(MakeMember(true, false, 0), empty));
+    EXPECT_TRUE(IsGroupCompatible(MakeMember(false, true, 2), empty));
+
+    ChallengeGroupSummary others;
+    others.Add(MakeMember(true, false, 0));
+    EXPECT_FALSE(IsGroupCompatible(MakeMember(false, false, 0), others));
+}
+
+TEST(ChallengeGroupIndexTest, HardcoreGroupsByTier)
+{
+    ChallengeGroupSummary hardcore;
+    hardcore.Add(MakeMember(false, true, 1));
+    hardcore.Add(MakeMember(false, true, 1));
+    EXPECT_TRUE(IsGroupCompatible(MakeMember(false, true, 1), hardcore));
+    EXPECT_FALSE(IsGroupCompatible(MakeMember(false, true, 2), hardcore));
+    EXPECT_FALSE(IsGroupCompatible(MakeMember(false, false, 0), hardcore));
+
+    ChallengeGroupSummary casual;
+    casual.Add(MakeMember(false, false, 0));
+    EXPECT_TRUE(IsGroupCompatible(MakeMember(false, false, 0), casual));
+    EXPECT_FALSE(IsGroupCompatible(MakeMember(false, true, 1), casual));
+}
+
+TEST(ChallengeGroupIndexTest, ConcurrentUpdatesKeepSummaryConsistent)
+{
+    ChallengeGroupIndex& index = ChallengeGroupIndex::Instance();
+    constexpr uint32 firstGroup = 200;
+    constexpr uint32 groupCount = 8;
+    constexpr uint32 membersPerGroup = 40;
+    constexpr uint32 writerCount = 4;
+    constexpr uint32 rounds = 200;
+
+    for (uint32 group = firstGroup; group < firstGroup + groupCount; ++group)
+        index.Seed(group, {});
+
+    std::atomic<bool> writersDone{ false };
+    std::atomic<uint32> inconsistent{ 0 };
+
+    std::vector<std::thread> threads;
+    for (uint32 writer = 0; writer < writerCount; ++writer)
+    {
+        threads.emplace_back([&, writer]()
+        {
+            for (uint32 round = 0; round < rounds; ++round)
+            {
+                for (uint32 group = firstGroup; group < firstGroup + groupCount; ++group)
+                {
+                    // Each writer owns a disjoint slice of every group's members.
+                    for (uint32 member = writer; member < membersPerGroup; member += writerCount)
+                    {
+                        uint32 guid = group * 1000 + member;
+                        if ((round + member) % 5 == 0)
+                            index.RemoveMember(group, guid);
+                        else
+                            index.SetMember(group, guid, MakeMember(member % 3 == 0, round % 2 == 0, uint8(1 + member % 3)));
+                    }
+                }
+            }
+        });
+    }
+
+    threads.emplace_back([&]()
+    {
+        while (!writersDone.load(std::memory_order_relaxed))
+        {
+            for (uint32 group = firstGroup; group < firstGroup + groupCount; ++group)
+            {
+                ChallengeGroupSummary summary;
+                if (!index.GetSummary(group, 0, summary) || summary.members != CountedMembers(summary) ||
+                    summary.soloOnly > summary.members || summary.members > membersPerGroup)
+                    inconsistent.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    });
+
+    for (uint32 writer = 0; writer < writerCount; ++writer)
+        threads[writer].join();
+    writersDone = true;
+    threads.back().join();
+
+    EXPECT_EQ(inconsistent.load(), 0u);
+
+    for (uint32 group = firstGroup; group < firstGroup + groupCount; ++group)
+    {
+        ChallengeGroupSummary summary;
+        ASSERT_TRUE(index.GetSummary(group, 0, summary));
+
+        // Final round (rounds - 1): members with (round + member) % 5 == 0 were removed.
+        uint32 expected = 0;
+        for (uint32 member = 0; member < membersPerGroup; ++member)
+            expected += ((rounds - 1 + member) % 5) != 0;
+        EXPECT_EQ(summary.members, expected);
+
+        index.Erase(group);
+    }
+}
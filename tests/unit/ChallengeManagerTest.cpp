@@ -0,0 +1,124 @@
+#include "ChallengeConfig.h"
+#include "ChallengeManager.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTimerWheel.h"
+#include "GameTime.h"
+#include "Group.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "SharedDefines.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+
+// ChallengeManager against the stand-in Player, Group and WorldSession in
+// stubs/, so the benchmarks time code that behaves like the module.
+
+namespace
+{
+constexpr uint32 kHardcore = ChallengeManager::FLAG_HARDCORE | ChallengeManager::FLAG_PERMADEATH;
+
+struct Character
+{
+    Character(uint32 guid, uint8 tier, uint32 flags, bool bot = false) : session(guid, bot), player(guid, &session)
+    {
+        ChallengeStateIndex::Instance().Publish(guid, tier, flags);
+        ObjectAccessor::AddObject(&player);
+    }
+
+    ~Character()
+    {
+        ChallengeTimerWheel::Instance().CancelAll(player.GetGUID().GetCounter());
+        ObjectAccessor::RemoveObject(&player);
+    }
+
+    WorldSession session;
+    Player player;
+};
+
+class ChallengeManagerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override { ChallengeConfig::Reload(); }
+};
+}
+
+TEST_F(ChallengeManagerTest, GiveXPAppliesXPRestrictions)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Character casual(5001, 1, 0);
+    Character half(5002, 1, ChallengeManager::FLAG_HALF_XP);
+    Character questOnly(5003, 1, ChallengeManager::FLAG_ONLY_QUEST_XP);
+
+    uint32 amount = 200;
+    manager.HandleGiveXP(&casual.player, amount, XPSOURCE_KILL);
+    EXPECT_EQ(amount, 200u);
+
+    amount = 200;
+    manager.HandleGiveXP(&half.player, amount, XPSOURCE_KILL);
+    EXPECT_EQ(amount, 100u);
+
+    amount = 200;
+    manager.HandleGiveXP(&questOnly.player, amount, XPSOURCE_KILL);
+    EXPECT_EQ(amount, 0u);
+
+    amount = 200;
+    manager.HandleGiveXP(&questOnly.player, amount, XPSOURCE_QUEST);
+    EXPECT_EQ(amount, 200u);
+}
+
+TEST_F(ChallengeManagerTest, GroupAcceptUsesSeededSummary)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Group group(5100);
+    Character leader(5101, 1, kHardcore);
+    Character hardcore(5102, 1, kHardcore);
+    Character casual(5103, 1, 0);
+    group.AddMember(&leader.player);
+    manager.SeedGroupSummary(&group);
+
+    EXPECT_TRUE(manager.HandleGroupAccept(&hardcore.player, &group));
+    EXPECT_FALSE(manager.HandleGroupAccept(&casual.player, &group));
+}
+
+TEST_F(ChallengeManagerTest, InvalidGroupRemovesMembersAfterGrace)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Group group(5200);
+    Character hardcore(5201, 1, kHardcore);
+    Character casual(5202, 1, 0);
+    group.AddMember(&hardcore.player);
+    group.AddMember(&casual.player);
+    manager.SeedGroupSummary(&group);
+
+    uint32 graceMs = ChallengeConfig::Current().groupGracePeriodSeconds * IN_MILLISECONDS;
+    for (uint32 elapsed = 0; elapsed <= graceMs; elapsed += ChallengeTimerWheel::kResolutionMs)
+    {
+        manager.HandlePlayerUpdate(&hardcore.player, ChallengeTimerWheel::kResolutionMs);
+        manager.HandlePlayerUpdate(&casual.player, ChallengeTimerWheel::kResolutionMs);
+        manager.UpdateTimers(ChallengeTimerWheel::kResolutionMs);
+    }
+
+    EXPECT_EQ(hardcore.player.GetGroup(), nullptr);
+    EXPECT_EQ(casual.player.GetGroup(), nullptr);
+    EXPECT_GT(hardcore.session.messageCount, 0u);
+}
+
+TEST_F(ChallengeManagerTest, BotChatBlocksCombatCommandsToCasualBots)
+{
+    ChallengeManager& manager = ChallengeManager::Instance();
+    Group group(5300);
+    Character master(5301, 1, kHardcore);
+    Character bot(5302, 0, 0, true);
+    group.AddMember(&master.player);
+    group.AddMember(&bot.player);
+
+    EXPECT_TRUE(manager.HandleBotChat(&master.player, LANG_UNIVERSAL, "anyone up for a dungeon?", nullptr, &group));
+    EXPECT_EQ(master.session.messageCount, 0u);
+
+    EXPECT_FALSE(manager.HandleBotChat(&master.player, LANG_UNIVERSAL, "attack", nullptr, &group));
+    EXPECT_EQ(master.session.messageCount, 1u);
+
+    EXPECT_TRUE(manager.HandleBotChat(&master.player, LANG_ADDON, "attack", nullptr, &group));
+}
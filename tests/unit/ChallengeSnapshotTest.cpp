@@ -0,0 +1,73 @@
+#include "ChallengeSnapshot.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+struct Tracked
+{
+    explicit Tracked(int& liveCount, int value) : live(liveCount), value(value) { ++live; }
+    ~Tracked() { --live; }
+
+    int& live;
+    int value;
+};
+}
+
+TEST(ChallengeSnapshotTest, EmptyUntilFirstPublish)
+{
+    ChallengeSnapshot<Tracked> snapshot;
+    EXPECT_EQ(snapshot.Get(), nullptr);
+    snapshot.Reclaim();
+    EXPECT_EQ(snapshot.GetRetiredCount(), 0u);
+}
+
+TEST(ChallengeSnapshotTest, SupersededSnapshotsOutliveTheGracePeriodOnly)
+{
+    int live = 0;
+    {
+        ChallengeSnapshot<Tracked> snapshot;
+        snapshot.Publish(std::make_unique<Tracked>(live, 1));
+        Tracked const* first = snapshot.Get();
+        ASSERT_NE(first, nullptr);
+
+        snapshot.Publish(std::make_unique<Tracked>(live, 2));
+        EXPECT_EQ(snapshot.Get()->value, 2);
+
+        // A reader that loaded the old snapshot before the swap can still use it.
+        EXPECT_EQ(first->value, 1);
+        EXPECT_EQ(live, 2);
+
+        for (uint32 update = 1; update < ChallengeSnapshot<Tracked>::kGraceUpdates; ++update)
+        {
+            snapshot.Reclaim();
+            EXPECT_EQ(live, 2);
+        }
+
+        snapshot.Reclaim();
+        EXPECT_EQ(live, 1);
+        EXPECT_EQ(snapshot.GetRetiredCount(), 0u);
+        EXPECT_EQ(snapshot.Get()->value, 2);
+    }
+
+    EXPECT_EQ(live, 0);
+}
+
+TEST(ChallengeSnapshotTest, RepeatedReloadsDoNotAccumulate)
+{
+    int live = 0;
+    ChallengeSnapshot<Tracked> snapshot;
+    for (int reload = 0; reload < 100; ++reload)
+    {
+        snapshot.Publish(std::make_unique<Tracked>(live, reload));
+        snapshot.Reclaim();
+    }
+
+    EXPECT_LE(snapshot.GetRetiredCount(), size_t(ChallengeSnapshot<Tracked>::kGraceUpdates));
+
+    for (uint32 update = 0; update < ChallengeSnapshot<Tracked>::kGraceUpdates; ++update)
+        snapshot.Reclaim();
+
+    EXPECT_EQ(live, 1);
+    EXPECT_EQ(snapshot.Get()->value, 99);
+}
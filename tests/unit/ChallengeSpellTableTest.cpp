@@ -0,0 +1,88 @@
+#include "ChallengeConfig.h"
+#include "ChallengeSpellTable.h"
+#include "SpellMgr.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+constexpr uint32 kMount = 458;
+constexpr uint32 kBuff = 1126;
+constexpr uint32 kAllowListedBuff = 1243;
+constexpr uint32 kPassiveBuff = 20550;
+constexpr uint32 kDebuff = 770;
+constexpr uint32 kMissing = 1500;
+
+void FillSpellStore()
+{
+    std::vector<std::unique_ptr<SpellInfo>>& store = sSpellMgr->store;
+    store.clear();
+    store.resize(kPassiveBuff + 1);
+    store[kMount] = std::make_unique<SpellInfo>(kMount, true, false, SPELL_AURA_MOUNTED);
+    store[kBuff] = std::make_unique<SpellInfo>(kBuff, true, false, SPELL_AURA_NONE);
+    store[kAllowListedBuff] = std::make_unique<SpellInfo>(kAllowListedBuff, true, false, SPELL_AURA_NONE);
+    store[kPassiveBuff] = std::make_unique<SpellInfo>(kPassiveBuff, true, true, SPELL_AURA_NONE);
+    store[kDebuff] = std::make_unique<SpellInfo>(kDebuff, false, false, SPELL_AURA_NONE);
+}
+
+ChallengeConfig MakeConfig(bool allowPassive)
+{
+    ChallengeConfig config;
+    config.noBuffsAllowPassive = allowPassive;
+    config.noBuffsAllowSpells = { kAllowListedBuff };
+    return config;
+}
+}
+
+TEST(ChallengeSpellTableTest, EmptyBeforeFirstBuild)
+{
+    EXPECT_FALSE(ChallengeSpellTable::Current().Has(kMount, ChallengeSpellClass::Mount));
+    EXPECT_FALSE(ChallengeSpellTable::Current().IsForbiddenBuff(kBuff));
+    EXPECT_EQ(ChallengeSpellTable::Current().GetSpellCount(), 0u);
+}
+
+TEST(ChallengeSpellTableTest, ClassifiesMounts)
+{
+    FillSpellStore();
+    ChallengeSpellTable::Build(MakeConfig(true));
+
+    ChallengeSpellTable const& table = ChallengeSpellTable::Current();
+    EXPECT_EQ(table.GetSpellCount(), 5u);
+    EXPECT_TRUE(table.Has(kMount, ChallengeSpellClass::Mount));
+    EXPECT_FALSE(table.Has(kBuff, ChallengeSpellClass::Mount));
+    EXPECT_FALSE(table.Has(kMissing, ChallengeSpellClass::Mount));
+    // Past the end of the store.
+    EXPECT_FALSE(table.Has(kPassiveBuff + 1000, ChallengeSpellClass::Mount));
+}
+
+TEST(ChallengeSpellTableTest, ForbiddenBuffsHonourAllowList)
+{
+    FillSpellStore();
+    ChallengeSpellTable::Build(MakeConfig(true));
+
+    ChallengeSpellTable const& table = ChallengeSpellTable::Current();
+    EXPECT_TRUE(table.IsForbiddenBuff(kBuff));
+    EXPECT_TRUE(table.IsForbiddenBuff(kMount));
+    EXPECT_FALSE(table.IsForbiddenBuff(kAllowListedBuff));
+    EXPECT_FALSE(table.IsForbiddenBuff(kPassiveBuff));
+    EXPECT_FALSE(table.IsForbiddenBuff(kDebuff));
+    EXPECT_FALSE(table.IsForbiddenBuff(kMissing));
+}
+
+TEST(ChallengeSpellTableTest, RebuildFoldsInNewConfig)
+{
+    FillSpellStore();
+    ChallengeSpellTable::Build(MakeConfig(true));
+    EXPECT_FALSE(ChallengeSpellTable::Current().IsForbiddenBuff(kPassiveBuff));
+
+    // AllowPassive off: passive buffs are removed too, the allow list still applies.
+    ChallengeSpellTable::Build(MakeConfig(false));
+    ChallengeSpellTable const& table = ChallengeSpellTable::Current();
+    EXPECT_TRUE(table.IsForbiddenBuff(kPassiveBuff));
+    EXPECT_FALSE(table.IsForbiddenBuff(kAllowListedBuff));
+
+    ChallengeSpellTable::ReclaimRetired();
+    ChallengeSpellTable::ReclaimRetired();
+    ChallengeSpellTable::ReclaimRetired();
+    EXPECT_TRUE(ChallengeSpellTable::Current().IsForbiddenBuff(kPassiveBuff));
+}
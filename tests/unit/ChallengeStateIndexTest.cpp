@@ -0,0 +1,136 @@
+#include "ChallengeStateIndex.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+// Every published pair satisfies flags == FlagsFor(tier, round), so a reader
+// that sees a tier from one Publish and flags from another fails the check.
+uint32 FlagsFor(uint8 tier, uint32 round)
+{
+    return (round << 2) | tier;
+}
+}
+
+TEST(ChallengeStateIndexTest, PublishFindAndErase)
+{
+    ChallengeStateIndex& index = ChallengeStateIndex::Instance();
+    constexpr uint32 guid = 1000001;
+
+    ChallengeStateIndex::Entry entry;
+    EXPECT_FALSE(index.Find(guid, entry));
+
+    size_t before = index.Size();
+    index.Publish(guid, 2, 0x41);
+    ASSERT_TRUE(index.Find(guid, entry));
+    EXPECT_EQ(entry.tier, 2);
+    EXPECT_EQ(entry.flags, 0x41u);
+    EXPECT_EQ(index.Size(), before + 1);
+
+    index.Publish(guid, 3, 0x5);
+    ASSERT_TRUE(index.Find(guid, entry));
+    EXPECT_EQ(entry.tier, 3);
+    EXPECT_EQ(entry.flags, 0x5u);
+    EXPECT_EQ(index.Size(), before + 1);
+
+    // (0, 0) removes the entry instead of storing an empty one.
+    index.Publish(guid, 0, 0);
+    EXPECT_FALSE(index.Find(guid, entry));
+    EXPECT_EQ(index.Size(), before);
+
+    // Either half alone is still a state worth keeping.
+    index.Publish(guid, 0, 0x8);
+    EXPECT_TRUE(index.Find(guid, entry));
+    index.Publish(guid, 0, 0);
+    EXPECT_FALSE(index.Find(guid, entry));
+}
+
+TEST(ChallengeStateIndexTest, PublishReturnsReplacedEntry)
+{
+    ChallengeStateIndex& index = ChallengeStateIndex::Instance();
+    constexpr uint32 guid = 1000002;
+
+    ChallengeStateIndex::Entry previous = index.Publish(guid, 2, 0x41);
+    EXPECT_EQ(previous.tier, 0);
+    EXPECT_EQ(previous.flags, 0u);
+
+    previous = index.Publish(guid, 1, 0x1);
+    EXPECT_EQ(previous.tier, 2);
+    EXPECT_EQ(previous.flags, 0x41u);
+
+    previous = index.Publish(guid, 0, 0);
+    EXPECT_EQ(previous.tier, 1);
+    EXPECT_EQ(previous.flags, 0x1u);
+}
+
+TEST(ChallengeStateIndexTest, ConcurrentPublishAndFindNeverTear)
+{
+    ChallengeStateIndex& index = ChallengeStateIndex::Instance();
+    constexpr uint32 firstGuid = 2000000;
+    constexpr uint32 guidsPerWriter = 256;
+    constexpr uint32 writerCount = 4;
+    constexpr uint32 readerCount = 4;
+    constexpr uint32 rounds = 200;
+
+    size_t before = index.Size();
+    std::atomic<bool> writersDone{ false };
+    std::atomic<uint32> tornReads{ 0 };
+    std::atomic<uint64> hits{ 0 };
+
+    std::vector<std::thread> threads;
+    for (uint32 writer = 0; writer < writerCount; ++writer)
+    {
+        threads.emplace_back([&, writer]()
+        {
+            uint32 begin = firstGuid + writer * guidsPerWriter;
+            for (uint32 round = 1; round <= rounds; ++round)
+            {
+                for (uint32 guid = begin; guid < begin + guidsPerWriter; ++guid)
+                {
+                    uint8 tier = static_cast<uint8>(1 + (guid + round) % 3);
+                    // Every fourth round erases, so readers also race against removal.
+                    if (round % 4 == 0)
+                        index.Publish(guid, 0, 0);
+                    else
+                        index.Publish(guid, tier, FlagsFor(tier, round));
+                }
+            }
+        });
+    }
+
+    for (uint32 reader = 0; reader < readerCount; ++reader)
+    {
+        threads.emplace_back([&, reader]()
+        {
+            uint32 guid = firstGuid + reader;
+            while (!writersDone.load(std::memory_order_relaxed))
+            {
+                ChallengeStateIndex::Entry entry;
+                if (index.Find(guid, entry))
+                {
+                    hits.fetch_add(1, std::memory_order_relaxed);
+                    if ((entry.flags & 0x3) != entry.tier)
+                        tornReads.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                guid = firstGuid + (guid - firstGuid + 7919) % (writerCount * guidsPerWriter);
+            }
+        });
+    }
+
+    for (uint32 writer = 0; writer < writerCount; ++writer)
+        threads[writer].join();
+    writersDone = true;
+    for (size_t i = writerCount; i < threads.size(); ++i)
+        threads[i].join();
+
+    EXPECT_EQ(tornReads.load(), 0u);
+    EXPECT_GT(hits.load(), 0u);
+
+    // The last round (200) erased everything the writers published.
+    EXPECT_EQ(index.Size(), before);
+}
@@ -0,0 +1,164 @@
+#include "ChallengeTimerWheel.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+constexpr uint32 kTickMs = ChallengeTimerWheel::kResolutionMs;
+
+// 4 levels of 64 slots: the longest schedulable delay, in ticks.
+constexpr uint64 kMaxTicks = (uint64(1) << 24) - 1;
+
+using FiredTicks = std::map<std::pair<uint32, ChallengeTimer>, std::vector<uint64>>;
+
+// Advances the wheel one tick at a time and records the tick each timer fired in.
+void AdvanceTicks(uint64 ticks, uint64& tick, FiredTicks& fired)
+{
+    std::vector<ChallengeTimerWheel::Expired> expired;
+    for (uint64 i = 0; i < ticks; ++i)
+    {
+        ++tick;
+        expired.clear();
+        ChallengeTimerWheel::Instance().Update(kTickMs, expired);
+        for (ChallengeTimerWheel::Expired const& timer : expired)
+            fired[{ timer.guid, timer.timer }].push_back(tick);
+    }
+}
+
+std::vector<uint64> FiredIn(FiredTicks const& fired, uint32 guid, ChallengeTimer timer)
+{
+    auto itr = fired.find({ guid, timer });
+    return itr != fired.end() ? itr->second : std::vector<uint64>();
+}
+
+uint64 TicksFor(uint32 delayMs)
+{
+    return delayMs ? (uint64(delayMs) + kTickMs - 1) / kTickMs : 1;
+}
+}
+
+TEST(ChallengeTimerWheelTest, FiresOnceInTheScheduledTickAcrossLevels)
+{
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    uint64 tick = 0;
+    FiredTicks fired;
+
+    // Start mid-lap so level boundaries do not line up with the schedule time.
+    AdvanceTicks(37, tick, fired);
+
+    // Level 0 spans 64 ticks, level 1 4096, level 2 262144.
+    std::vector<uint32> const delays =
+    {
+        0, 1, 100, 150, 6300, 6400, 6500, 12700, 409500, 409600, 409700, 1000000, 26214400, 26300000
+    };
+
+    uint32 guid = 5000;
+    std::map<uint32, uint64> expected;
+    for (uint32 delay : delays)
+    {
+        wheel.Schedule(guid, ChallengeTimer::GroupGrace, delay);
+        expected[guid] = tick + TicksFor(delay);
+        ++guid;
+    }
+
+    AdvanceTicks(TicksFor(delays.back()) + 64, tick, fired);
+
+    for (auto const& [timerGuid, expectedTick] : expected)
+    {
+        EXPECT_EQ(FiredIn(fired, timerGuid, ChallengeTimer::GroupGrace), std::vector<uint64>{ expectedTick })
+            << "guid " << timerGuid;
+    }
+    EXPECT_EQ(fired.size(), expected.size());
+}
+
+TEST(ChallengeTimerWheelTest, PartialUpdatesAccumulateIntoTicks)
+{
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    std::vector<ChallengeTimerWheel::Expired> expired;
+
+    wheel.Schedule(6000, ChallengeTimer::GroupWarning, 250);
+
+    wheel.Update(kTickMs / 2, expired);
+    wheel.Update(kTickMs, expired);
+    EXPECT_TRUE(expired.empty());
+
+    // 3 ticks = 300 ms: 50 + 100 + 100 + 50.
+    wheel.Update(kTickMs, expired);
+    EXPECT_TRUE(expired.empty());
+    wheel.Update(kTickMs / 2, expired);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0].guid, 6000u);
+    EXPECT_EQ(expired[0].timer, ChallengeTimer::GroupWarning);
+}
+
+TEST(ChallengeTimerWheelTest, CancelAndRescheduleOfFiredTimers)
+{
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    uint64 tick = 0;
+    FiredTicks fired;
+    constexpr uint32 guid = 7000;
+
+    // Rescheduling a pending timer replaces it.
+    wheel.Schedule(guid, ChallengeTimer::PermadeathKick, 10000);
+    wheel.Schedule(guid, ChallengeTimer::PermadeathKick, 500);
+    AdvanceTicks(5, tick, fired);
+    EXPECT_EQ(FiredIn(fired, guid, ChallengeTimer::PermadeathKick), std::vector<uint64>{ 5 });
+
+    // Cancelling a timer that already fired is a no-op and leaves others alone.
+    wheel.Schedule(guid, ChallengeTimer::NoBuffsScan, 300);
+    wheel.Cancel(guid, ChallengeTimer::PermadeathKick);
+
+    // A fired timer can be scheduled again.
+    wheel.Schedule(guid, ChallengeTimer::PermadeathKick, 7000);
+    AdvanceTicks(200, tick, fired);
+    EXPECT_EQ(FiredIn(fired, guid, ChallengeTimer::NoBuffsScan), std::vector<uint64>{ 8 });
+    EXPECT_EQ(FiredIn(fired, guid, ChallengeTimer::PermadeathKick), (std::vector<uint64>{ 5, 75 }));
+
+    // Cancelled before expiry: never fires, across a level boundary too.
+    wheel.Schedule(guid, ChallengeTimer::GroupGrace, 100);
+    wheel.Schedule(guid, ChallengeTimer::GroupWarning, 9000);
+    wheel.Cancel(guid, ChallengeTimer::GroupGrace);
+    AdvanceTicks(30, tick, fired);
+    wheel.Cancel(guid, ChallengeTimer::GroupWarning);
+    AdvanceTicks(100, tick, fired);
+    EXPECT_EQ(fired.count({ guid, ChallengeTimer::GroupGrace }), 0u);
+    EXPECT_EQ(fired.count({ guid, ChallengeTimer::GroupWarning }), 0u);
+}
+
+TEST(ChallengeTimerWheelTest, CancelAllDropsEveryTimerOfOneCharacter)
+{
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    uint64 tick = 0;
+    FiredTicks fired;
+
+    wheel.Schedule(8000, ChallengeTimer::GroupGrace, 100);
+    wheel.Schedule(8000, ChallengeTimer::NoBuffsScan, 500000);
+    wheel.Schedule(8001, ChallengeTimer::GroupGrace, 100);
+    wheel.CancelAll(8000);
+    wheel.CancelAll(8002); // nothing scheduled
+
+    AdvanceTicks(5001, tick, fired);
+    EXPECT_EQ(fired.size(), 1u);
+    EXPECT_EQ(FiredIn(fired, 8001, ChallengeTimer::GroupGrace), std::vector<uint64>{ 1 });
+}
+
+TEST(ChallengeTimerWheelTest, DelaysPastTheTopLevelAreClamped)
+{
+    ChallengeTimerWheel& wheel = ChallengeTimerWheel::Instance();
+    uint64 tick = 0;
+    FiredTicks fired;
+    constexpr uint32 guid = 9000;
+
+    AdvanceTicks(1234, tick, fired);
+    uint64 start = tick;
+    wheel.Schedule(guid, ChallengeTimer::PermadeathKick, ~0u);
+    wheel.Schedule(guid, ChallengeTimer::GroupGrace, uint32(kMaxTicks * kTickMs));
+
+    AdvanceTicks(kMaxTicks + 64, tick, fired);
+    EXPECT_EQ(FiredIn(fired, guid, ChallengeTimer::PermadeathKick), std::vector<uint64>{ start + kMaxTicks });
+    EXPECT_EQ(FiredIn(fired, guid, ChallengeTimer::GroupGrace), std::vector<uint64>{ start + kMaxTicks });
+}
@@ -0,0 +1,328 @@
+#include "ChallengeConfig.h"
+#include "ChallengeGroupIndex.h"
+#include "ChallengeManager.h"
+#include "ChallengeSpellTable.h"
+#include "ChallengeStateIndex.h"
+#include "ChallengeTrace.h"
+#include "ChallengeTraceReplay.h"
+#include "Config.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+void AddChallengeSystemRestrictions();
+
+namespace
+{
+constexpr uint32 kHardcore = ChallengeManager::FLAG_HARDCORE;
+
+class TraceBuilder
+{
+public:
+    TraceBuilder& At(uint32 timeMs)
+    {
+        _timeMs = timeMs;
+        return *this;
+    }
+
+    TraceBuilder& Add(ChallengeTraceHook hook, uint32 guid, uint32 arg0 = 0, uint32 arg1 = 0)
+    {
+        ChallengeTraceRecord& record = _records.emplace_back();
+        record.timeMs = _timeMs;
+        record.guid = guid;
+        record.arg0 = arg0;
+        record.arg1 = arg1;
+        record.hook = hook;
+        return *this;
+    }
+
+    // One Update per listed character every 100 ms up to timeMs.
+    TraceBuilder& UpdateUntil(uint32 timeMs, std::vector<uint32> const& guids)
+    {
+        for (uint32 now = _timeMs + 100; now <= timeMs; now += 100)
+        {
+            At(now);
+            for (uint32 guid : guids)
+                Add(ChallengeTraceHook::Update, guid, 100);
+        }
+        return *this;
+    }
+
+    std::vector<ChallengeTraceRecord> const& Get() const { return _records; }
+
+private:
+    uint32 _timeMs = 0;
+    std::vector<ChallengeTraceRecord> _records;
+};
+
+uint32 Count(ChallengeTraceReplay::Result const& result, ChallengeTraceHook hook)
+{
+    return result.counts[static_cast<size_t>(hook)];
+}
+
+uint32 Refused(ChallengeTraceReplay::Result const& result, ChallengeTraceHook hook)
+{
+    return result.refused[static_cast<size_t>(hook)];
+}
+
+// Replays go through ChallengeManager and its singletons, so each test uses guids of its own.
+class ChallengeTraceReplayTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        ChallengeConfig::Reload();
+        ChallengeSpellTable::Build(ChallengeConfig::Current());
+        AddChallengeSystemRestrictions();
+    }
+
+    void TearDown() override
+    {
+        sConfigMgr->ClearOptions();
+        ChallengeConfig::Reload();
+    }
+
+    static void SetOption(std::string const& name, std::string const& value)
+    {
+        sConfigMgr->SetOption(name, value);
+        ChallengeConfig::Reload();
+    }
+};
+}
+
+TEST_F(ChallengeTraceReplayTest, RecorderSeedsFromIndexesAndRoundTrips)
+{
+    ChallengeStateIndex::Instance().Publish(7001, 2, kHardcore);
+    ChallengeGroupIndex::Instance().Seed(70, { { 7001, ChallengeGroupMember() } });
+
+    std::string path = (std::filesystem::temp_directory_path() / "challenge_trace_test.bin").string();
+    ChallengeTraceRecorder& recorder = ChallengeTraceRecorder::Instance();
+    ASSERT_TRUE(recorder.Start(path));
+    recorder.Record(ChallengeTraceHook::Trade, 7001, 7002);
+    recorder.Stop();
+
+    std::vector<ChallengeTraceRecord> records;
+    ASSERT_TRUE(ChallengeTraceRecorder::Load(path, records));
+    std::remove(path.c_str());
+
+    auto seededState = std::find_if(records.begin(), records.end(), [](ChallengeTraceRecord const& record)
+    {
+        return record.hook == ChallengeTraceHook::StateChanged && record.guid == 7001;
+    });
+    ASSERT_NE(seededState, records.end());
+    EXPECT_EQ(seededState->timeMs, 0u);
+    EXPECT_EQ(seededState->arg0, 2u);
+    EXPECT_EQ(seededState->arg1, kHardcore);
+
+    EXPECT_TRUE(std::any_of(records.begin(), records.end(), [](ChallengeTraceRecord const& record)
+    {
+        return record.hook == ChallengeTraceHook::GroupAddMember && record.guid == 7001 && record.arg0 == 70;
+    }));
+
+    ASSERT_FALSE(records.empty());
+    EXPECT_EQ(records.back().hook, ChallengeTraceHook::Trade);
+    EXPECT_EQ(records.back().arg0, 7002u);
+
+    ChallengeGroupIndex::Instance().Erase(70);
+    ChallengeStateIndex::Instance().Publish(7001, 0, 0);
+}
+
+TEST_F(ChallengeTraceReplayTest, ResolvePathStaysInTraceDirectory)
+{
+    std::string path;
+    ASSERT_TRUE(ChallengeTraceRecorder::ResolvePath("traces", "raid.bin", path));
+    EXPECT_EQ(path, (std::filesystem::path("traces") / "raid.bin").string());
+    ASSERT_TRUE(ChallengeTraceRecorder::ResolvePath("traces", "2026/./raid.bin", path));
+    EXPECT_EQ(path, (std::filesystem::path("traces") / "2026" / "raid.bin").string());
+
+    EXPECT_FALSE(ChallengeTraceRecorder::ResolvePath("traces", "", path));
+    EXPECT_FALSE(ChallengeTraceRecorder::ResolvePath("traces", "/etc/passwd", path));
+    EXPECT_FALSE(ChallengeTraceRecorder::ResolvePath("traces", "../worldserver.conf", path));
+    EXPECT_FALSE(ChallengeTraceRecorder::ResolvePath("traces", "2026/../../worldserver.conf", path));
+    EXPECT_FALSE(ChallengeTraceRecorder::ResolvePath("traces", "..", path));
+}
+
+// A login storm: every character logs in, has its state set and trades,
+// receives mail and logs out, each with its own stand-in and state.
+TEST_F(ChallengeTraceReplayTest, LoginStormUsesPerGuidState)
+{
+    constexpr uint32 kCharacters = 500;
+    constexpr uint32 kGuidBase = 8000;
+
+    TraceBuilder trace;
+    for (uint32 i = 0; i < kCharacters; ++i)
+    {
+        uint32 guid = kGuidBase + i;
+        uint32 flags = i % 2 ? ChallengeManager::FLAG_NO_TRADE | ChallengeManager::FLAG_NO_MAIL : 0;
+        trace.At(i).Add(ChallengeTraceHook::Login, guid).Add(ChallengeTraceHook::StateChanged, guid, 1, flags);
+    }
+
+    trace.At(1000);
+    for (uint32 i = 0; i + 2 < kCharacters; i += 2)
+        trace.Add(ChallengeTraceHook::Trade, kGuidBase + i, kGuidBase + i + 2);
+    trace.Add(ChallengeTraceHook::Trade, kGuidBase, kGuidBase + 1);
+    for (uint32 i = 0; i < kCharacters; ++i)
+        trace.Add(ChallengeTraceHook::MailReceive, kGuidBase + i);
+    for (uint32 i = 0; i < kCharacters; ++i)
+        trace.Add(ChallengeTraceHook::Logout, kGuidBase + i);
+
+    ChallengeTraceReplay replay;
+    ChallengeTraceReplay::Result result = replay.Run(trace.Get());
+    EXPECT_EQ(result.records, trace.Get().size());
+    EXPECT_EQ(result.characters, kCharacters);
+    EXPECT_EQ(Count(result, ChallengeTraceHook::Login), kCharacters);
+    EXPECT_EQ(Count(result, ChallengeTraceHook::Logout), kCharacters);
+    EXPECT_EQ(Refused(result, ChallengeTraceHook::Trade), 1u);
+    EXPECT_EQ(Refused(result, ChallengeTraceHook::MailReceive), kCharacters / 2);
+
+    // Logged out characters stay indexed for offline checks.
+    ChallengeStateIndex::Entry entry;
+    ASSERT_TRUE(ChallengeStateIndex::Instance().Find(kGuidBase + 1, entry));
+    EXPECT_EQ(entry.flags, ChallengeManager::FLAG_NO_TRADE | ChallengeManager::FLAG_NO_MAIL);
+}
+
+TEST_F(ChallengeTraceReplayTest, TradeChecksBothCharacters)
+{
+    TraceBuilder trace;
+    trace.Add(ChallengeTraceHook::StateChanged, 9101, 1, ChallengeManager::FLAG_NO_TRADE)
+         .Add(ChallengeTraceHook::StateChanged, 9102, 1, kHardcore)
+         .Add(ChallengeTraceHook::Trade, 9101, 9102)
+         .Add(ChallengeTraceHook::Trade, 9102, 9101)
+         .Add(ChallengeTraceHook::Trade, 9102, 9103);
+
+    ChallengeTraceReplay replay;
+    EXPECT_EQ(Refused(replay.Run(trace.Get()), ChallengeTraceHook::Trade), 2u);
+}
+
+// A Hardcore group member drops Hardcore: every member's cached validity flips
+// on its next update, and the grace timer removes them from the group.
+TEST_F(ChallengeTraceReplayTest, InvalidGroupRunsGrace)
+{
+    constexpr uint32 kLeader = 9201;
+    constexpr uint32 kMember = 9202;
+    constexpr uint32 kThird = 9203;
+    constexpr uint32 kCasual = 9204;
+    constexpr uint32 kGroup = 9200;
+
+    SetOption("ChallengeSystem.GroupGracePeriod", "30");
+
+    TraceBuilder trace;
+    trace.Add(ChallengeTraceHook::StateChanged, kLeader, 1, kHardcore)
+         .Add(ChallengeTraceHook::StateChanged, kMember, 1, kHardcore)
+         .Add(ChallengeTraceHook::StateChanged, kThird, 1, kHardcore)
+         .Add(ChallengeTraceHook::Login, kLeader)
+         .Add(ChallengeTraceHook::Login, kMember)
+         .Add(ChallengeTraceHook::Login, kThird)
+         .Add(ChallengeTraceHook::Login, kCasual)
+         .Add(ChallengeTraceHook::GroupCreate, kLeader, kGroup)
+         .Add(ChallengeTraceHook::GroupAccept, kMember, kGroup)
+         .Add(ChallengeTraceHook::GroupAddMember, kMember, kGroup)
+         .Add(ChallengeTraceHook::GroupAccept, kThird, kGroup)
+         .Add(ChallengeTraceHook::GroupAddMember, kThird, kGroup)
+         .Add(ChallengeTraceHook::GroupInvite, kLeader, kCasual)
+         .UpdateUntil(1000, { kLeader, kMember, kThird })
+         .Add(ChallengeTraceHook::StateChanged, kMember, 1, 0)
+         .UpdateUntil(30000, { kLeader, kMember, kThird });
+
+    {
+        ChallengeTraceReplay replay;
+        ChallengeTraceReplay::Result result = replay.Run(trace.Get());
+        EXPECT_EQ(Refused(result, ChallengeTraceHook::GroupAccept), 0u);
+        EXPECT_EQ(Refused(result, ChallengeTraceHook::GroupInvite), 1u);
+
+        // In grace from 1.1 s, warned at 1.1, 11.1 and 21.1 s; still grouped.
+        Player* leader = replay.FindPlayer(kLeader);
+        ASSERT_NE(leader, nullptr);
+        ASSERT_NE(leader->GetGroup(), nullptr);
+        EXPECT_EQ(leader->GetSession()->messageCount, 3u);
+    }
+
+    trace.UpdateUntil(32000, { kLeader, kMember, kThird });
+    ChallengeTraceReplay replay;
+    replay.Run(trace.Get());
+    for (uint32 guid : { kLeader, kMember, kThird })
+        EXPECT_EQ(replay.FindPlayer(guid)->GetGroup(), nullptr);
+}
+
+TEST_F(ChallengeTraceReplayTest, SoloOnlyRefusedBeforeGroupExists)
+{
+    TraceBuilder trace;
+    trace.Add(ChallengeTraceHook::StateChanged, 9301, 1, ChallengeManager::FLAG_SOLO_ONLY)
+         .Add(ChallengeTraceHook::GroupAccept, 9301, 0)
+         .Add(ChallengeTraceHook::GroupAccept, 9302, 0)
+         .Add(ChallengeTraceHook::GroupAccept, 9301, 0, 1);
+
+    // The LFG accept is refused too while ChallengeSystem.SoloOnly.AllowLfg is off.
+    {
+        ChallengeTraceReplay replay;
+        EXPECT_EQ(Refused(replay.Run(trace.Get()), ChallengeTraceHook::GroupAccept), 2u);
+    }
+
+    SetOption("ChallengeSystem.SoloOnly.AllowLfg", "1");
+    ChallengeTraceReplay replay;
+    EXPECT_EQ(Refused(replay.Run(trace.Get()), ChallengeTraceHook::GroupAccept), 1u);
+}
+
+// A counted death schedules the permadeath kick, which fires on the trace's clock.
+TEST_F(ChallengeTraceReplayTest, PermadeathSchedulesKick)
+{
+    SetOption("ChallengeSystem.Permadeath.KickDelaySeconds", "5");
+
+    auto deathTrace = [](uint32 guid, uint32 endMs)
+    {
+        TraceBuilder trace;
+        trace.Add(ChallengeTraceHook::StateChanged, guid, 1, kHardcore | ChallengeManager::FLAG_PERMADEATH)
+             .Add(ChallengeTraceHook::Login, guid)
+             .Add(ChallengeTraceHook::Death, guid, 1)
+             .Add(ChallengeTraceHook::StateChanged, guid, 0, 0)
+             .At(endMs).Add(ChallengeTraceHook::Update, guid, 100);
+        return trace;
+    };
+
+    ChallengeTraceReplay early;
+    early.Run(deathTrace(9401, 4900).Get());
+    EXPECT_EQ(early.FindPlayer(9401)->GetSession()->GetLogoutStartTime(), 0);
+
+    ChallengeTraceReplay kicked;
+    kicked.Run(deathTrace(9402, 5000).Get());
+    EXPECT_NE(kicked.FindPlayer(9402)->GetSession()->GetLogoutStartTime(), 0);
+}
+
+TEST_F(ChallengeTraceReplayTest, EquipAndXPFollowRecordedArguments)
+{
+    TraceBuilder trace;
+    trace.Add(ChallengeTraceHook::StateChanged, 9501, 1, ChallengeManager::FLAG_LOW_QUALITY_ONLY | ChallengeManager::FLAG_HALF_XP)
+         .Add(ChallengeTraceHook::EquipItem, 9501, 100, ChallengeTraceRecord::PackEquip(4, 1, false))
+         .Add(ChallengeTraceHook::EquipItem, 9501, 101, ChallengeTraceRecord::PackEquip(4, 3, true))
+         .Add(ChallengeTraceHook::GiveXP, 9501, 200, 0)
+         .Add(ChallengeTraceHook::GiveXP, 9502, 200, 0);
+
+    ChallengeTraceReplay replay;
+    ChallengeTraceReplay::Result result = replay.Run(trace.Get());
+    EXPECT_EQ(Refused(result, ChallengeTraceHook::EquipItem), 1u);
+    EXPECT_EQ(Refused(result, ChallengeTraceHook::GiveXP), 1u);
+}
+
+// Bot chat is classified again from the configured combat commands and refused
+// when it addresses a casual bot.
+TEST_F(ChallengeTraceReplayTest, BotChatAddressesRecordedBot)
+{
+    constexpr uint32 kMaster = 9601;
+    constexpr uint32 kBot = 9602;
+
+    TraceBuilder trace;
+    trace.Add(ChallengeTraceHook::StateChanged, kMaster, 1, kHardcore)
+         .Add(ChallengeTraceHook::GroupCreate, kMaster, 9600)
+         .Add(ChallengeTraceHook::GroupAddMember, kBot, 9600)
+         .Add(ChallengeTraceHook::BotChat, kMaster, 1, kBot)
+         .Add(ChallengeTraceHook::BotChat, kMaster, 0, 0);
+
+    ChallengeTraceReplay replay;
+    ChallengeTraceReplay::Result result = replay.Run(trace.Get());
+    EXPECT_EQ(Count(result, ChallengeTraceHook::BotChat), 2u);
+    EXPECT_EQ(Refused(result, ChallengeTraceHook::BotChat), 1u);
+}